@@ -16,8 +16,14 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Config.hpp>
 #include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <algorithm>
+#include <compare>
+#include <iterator>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -40,15 +46,16 @@ protected:
 public:
     /** The iterator type for the index of all symbols.
 
-        The iterator is a forward iterator that
-        iterates over all symbols in the index.
+        The iterator is a random access iterator
+        over the index of all symbols, which is
+        built once the corpus is complete.
         It dereferences to a reference to a
         const @ref Info.
 
-        The logic for incrementing the iterator is
-        provided by the Corpus implementation via
-        a function that retuns the next Info in the
-        index, or nullptr if there are no more.
+        The symbols in the index are ordered by
+        fully qualified name, and then by symbol ID,
+        so the order does not depend on how the
+        corpus was built.
     */
     class iterator;
 
@@ -84,6 +91,39 @@ public:
     bool
     empty() const noexcept;
 
+    /** Return the number of symbols in the index.
+    */
+    std::size_t
+    size() const noexcept;
+
+    /** Return the symbol at the specified position in the index.
+
+        If the position is out of range, the behavior is undefined.
+    */
+    Info const&
+    operator[](std::size_t i) const noexcept;
+
+    /** Invoke a function object for each symbol in the index.
+
+        The index is split into contiguous ranges,
+        which are visited concurrently on the thread
+        pool. The function object is invoked with a
+        reference to a const @ref Info, and may be
+        invoked concurrently from several threads.
+
+        @return Zero or more errors which were
+        thrown by the function object.
+
+        @param threadPool The pool which runs the work.
+        @param f The function to invoke.
+    */
+    template<class F>
+    [[nodiscard]]
+    std::vector<Error>
+    parallelForEach(
+        ThreadPool& threadPool,
+        F const& f) const;
+
     /** Return the Info with the matching ID, or nullptr.
     */
     MRDOCS_DECL
@@ -91,6 +131,55 @@ public:
     Info const*
     find(SymbolID const& id) const noexcept = 0;
 
+    /** Return the symbols of the specified kind.
+
+        The symbols are in the order of the index.
+    */
+    MRDOCS_DECL
+    virtual
+    std::span<Info const* const>
+    findByKind(InfoKind kind) const noexcept = 0;
+
+    /** Return the symbols with the specified unqualified name.
+
+        The symbols are in the order of the index.
+    */
+    MRDOCS_DECL
+    virtual
+    std::span<Info const* const>
+    findByName(std::string_view name) const noexcept = 0;
+
+    /** Return the symbols declared or defined in the specified file.
+
+        The file is matched against both the full
+        path and the name of the locations of each
+        symbol. The symbols are in the order of
+        the index.
+    */
+    MRDOCS_DECL
+    virtual
+    std::span<Info const* const>
+    findByFile(std::string_view file) const noexcept = 0;
+
+    /** Return the unqualified names indexed by @ref findByName.
+
+        The names are sorted.
+    */
+    MRDOCS_DECL
+    virtual
+    std::span<std::string_view const>
+    indexedNames() const noexcept = 0;
+
+    /** Return the files indexed by @ref findByFile.
+
+        The full paths and the names of the
+        files are both included, and sorted.
+    */
+    MRDOCS_DECL
+    virtual
+    std::span<std::string_view const>
+    indexedFiles() const noexcept = 0;
+
     /** Return true if an Info with the specified symbol ID exists.
 
         This function uses the @ref find function to locate
@@ -172,6 +261,9 @@ public:
         with the same name, the function object `f` is
         invoked with an @ref OverloadSet as the first
         argument, followed by `args...`.
+
+        The overload sets computed when the corpus
+        was finalized are used if the scope has any.
     */
     template <class F, class... Args>
     void traverseOverloads(
@@ -230,6 +322,28 @@ traverseOverloads(
     ScopeInfo const& S,
     F&& f, Args&&... args) const
 {
+    if(! S.OverloadGroups.empty())
+    {
+        for(OverloadGroup const& group : S.OverloadGroups)
+        {
+            const Info& member = get(group.Member);
+            if(group.Count == 0)
+            {
+                visit(member, std::forward<F>(f),
+                    std::forward<Args>(args)...);
+                continue;
+            }
+            OverloadSet overloads(member.Name,
+                member.Namespace.front(),
+                member.Namespace,
+                std::span(S.OverloadMembers).subspan(
+                    group.First, group.Count));
+            visit(overloads, std::forward<F>(f),
+                std::forward<Args>(args)...);
+        }
+        return;
+    }
+
     for(const SymbolID& id : S.Members)
     {
         const Info& member = get(id);
@@ -263,11 +377,11 @@ traverseOverloads(
 
 class Corpus::iterator
 {
-    const Corpus* corpus_;
-    const Info* val_;
-    const Info*(*next_)(const Corpus*, const Info*);
+    const Info* const* pos_ = nullptr;
 
 public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
     using value_type = const Info;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
@@ -280,53 +394,142 @@ public:
     iterator(const iterator&) = default;
     iterator& operator=(const iterator&) = default;
 
+    explicit
     iterator(
-        const Corpus* corpus,
-        const Info* val,
-        const Info*(*next)(const Corpus*, const Info*))
-        : corpus_(corpus)
-        , val_(val)
-        , next_(next)
+        const Info* const* pos) noexcept
+        : pos_(pos)
     {
     }
 
     iterator& operator++() noexcept
     {
-        MRDOCS_ASSERT(val_);
-        val_ = next_(corpus_, val_);
+        ++pos_;
         return *this;
     }
 
     iterator operator++(int) noexcept
     {
-        MRDOCS_ASSERT(val_);
         auto temp = *this;
-        val_ = next_(corpus_, val_);
+        ++pos_;
         return temp;
     }
 
+    iterator& operator--() noexcept
+    {
+        --pos_;
+        return *this;
+    }
+
+    iterator operator--(int) noexcept
+    {
+        auto temp = *this;
+        --pos_;
+        return temp;
+    }
+
+    iterator& operator+=(difference_type n) noexcept
+    {
+        pos_ += n;
+        return *this;
+    }
+
+    iterator& operator-=(difference_type n) noexcept
+    {
+        pos_ -= n;
+        return *this;
+    }
+
+    friend iterator operator+(iterator it, difference_type n) noexcept
+    {
+        return it += n;
+    }
+
+    friend iterator operator+(difference_type n, iterator it) noexcept
+    {
+        return it += n;
+    }
+
+    friend iterator operator-(iterator it, difference_type n) noexcept
+    {
+        return it -= n;
+    }
+
+    friend difference_type operator-(
+        iterator const& lhs, iterator const& rhs) noexcept
+    {
+        return lhs.pos_ - rhs.pos_;
+    }
+
     const_pointer operator->() const noexcept
     {
-        MRDOCS_ASSERT(val_);
-        return val_;
+        MRDOCS_ASSERT(pos_);
+        return *pos_;
     }
 
     const_reference operator*() const noexcept
     {
-        MRDOCS_ASSERT(val_);
-        return *val_;
+        MRDOCS_ASSERT(pos_);
+        return **pos_;
     }
 
-    bool operator==(iterator const& other) const noexcept
+    const_reference operator[](difference_type n) const noexcept
     {
-        return val_ == other.val_;
+        MRDOCS_ASSERT(pos_);
+        return *pos_[n];
     }
 
-    bool operator!=(iterator const& other) const noexcept
+    bool operator==(iterator const& other) const noexcept = default;
+
+    auto operator<=>(iterator const& other) const noexcept = default;
+};
+
+static_assert(std::random_access_iterator<Corpus::iterator>);
+
+inline
+std::size_t
+Corpus::
+size() const noexcept
+{
+    return static_cast<std::size_t>(end() - begin());
+}
+
+inline
+Info const&
+Corpus::
+operator[](std::size_t i) const noexcept
+{
+    MRDOCS_ASSERT(i < size());
+    return begin()[static_cast<std::ptrdiff_t>(i)];
+}
+
+template<class F>
+std::vector<Error>
+Corpus::
+parallelForEach(
+    ThreadPool& threadPool,
+    F const& f) const
+{
+    // A few ranges per thread, so that the
+    // threads remain busy when the cost of
+    // the symbols is uneven
+    std::size_t const n = size();
+    std::size_t const tasks = std::min<std::size_t>(n,
+        std::max(threadPool.getThreadCount(), 1u) * 4);
+    TaskGroup taskGroup(threadPool);
+    for(std::size_t t = 0; t < tasks; ++t)
     {
-        return val_ != other.val_;
+        taskGroup.async(
+            [this, &f,
+                first = n * t / tasks,
+                last = n * (t + 1) / tasks]
+            {
+                auto const it = begin();
+                for(std::size_t i = first; i < last; ++i)
+                    f(it[static_cast<std::ptrdiff_t>(i)]);
+            });
     }
-};
+    return taskGroup.wait();
+}
 
 } // mrdocs
 } // clang
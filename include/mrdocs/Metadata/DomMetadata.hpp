@@ -82,6 +82,19 @@ public:
     dom::Value
     get(SymbolID const& id) const;
 
+    /** Return a Dom object with the indexes of the corpus.
+
+        The object has the properties `kind`, `name`
+        and `file`. Each of them is an object whose
+        property names are the keys of the index, and
+        whose values are arrays of the symbols with
+        that kind, unqualified name, or source file.
+        The arrays are created when they are accessed,
+        and the indexes are read-only.
+    */
+    dom::Object
+    getIndexes() const;
+
     /** Return a Dom value representing the Javadoc.
 
         The default implementation returns null. A
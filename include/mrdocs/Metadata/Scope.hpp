@@ -13,6 +13,7 @@
 
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -20,6 +21,31 @@
 namespace clang {
 namespace mrdocs {
 
+/** A member of a scope, and its overloads.
+
+    The members of a scope are grouped into
+    overload sets when the corpus is finalized,
+    so that they can be traversed without
+    searching the lookup table of the scope.
+*/
+struct OverloadGroup
+{
+    /** The member at which the group is visited.
+
+        For an overload set, this is the first
+        function with the name of the set.
+    */
+    SymbolID Member;
+
+    /** The index of the first overload in @ref ScopeInfo::OverloadMembers.
+    */
+    std::uint32_t First = 0;
+
+    /** The number of overloads, or zero if the member is not overloaded.
+    */
+    std::uint32_t Count = 0;
+};
+
 /** Stores the members and lookups for an Info.
 
     Members are the symbols that are directly
@@ -40,6 +66,16 @@ struct ScopeInfo
 	*/
 	std::unordered_map<std::string,
         std::vector<SymbolID>> Lookups;
+
+    /** The members grouped into overload sets.
+
+        This is empty until the corpus is finalized.
+    */
+    std::vector<OverloadGroup> OverloadGroups;
+
+    /** The overloads of the groups, stored contiguously.
+    */
+    std::vector<SymbolID> OverloadMembers;
 };
 
 } // mrdocs
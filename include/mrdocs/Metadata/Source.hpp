@@ -16,6 +16,7 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/ADT/Optional.hpp>
 #include <mrdocs/Metadata/Info.hpp>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -36,16 +37,56 @@ MRDOCS_DECL
 std::string_view
 toString(FileKind kind);
 
-struct MRDOCS_DECL
-    Location
+/** The table of interned source files.
+
+    Every distinct source file of a location is
+    stored once per process, and a @ref Location
+    refers to it by its index. The index zero is
+    the file with empty paths.
+
+    Files are never removed from the table, so the
+    paths returned by @ref get remain valid until
+    the end of the process. The table may be used
+    concurrently.
+*/
+class MRDOCS_DECL
+    FileTable
 {
-    /** The full file path
+public:
+    /** A file of the table.
+    */
+    struct Entry
+    {
+        /** The full file path
+        */
+        std::string Path;
+
+        /** Name of the file
+        */
+        std::string Filename;
+    };
+
+    /** Return the index of a file, adding it if needed.
+    */
+    static
+    std::uint32_t
+    intern(
+        std::string_view path,
+        std::string_view filename);
+
+    /** Return the file with the specified index.
     */
-    std::string Path;
+    static
+    Entry const&
+    get(std::uint32_t index) noexcept;
+};
 
-    /** Name of the file
+struct MRDOCS_DECL
+    Location
+{
+    /** The index of the file in the @ref FileTable
     */
-    std::string Filename;
+    std::uint32_t File = 0;
 
     /** Line number within the file
     */
@@ -67,13 +108,40 @@ struct MRDOCS_DECL
         unsigned line = 0,
         FileKind kind = FileKind::Source,
         bool documented = false)
-        : Path(filepath)
-        , Filename(filename)
+        : File(FileTable::intern(filepath, filename))
         , LineNumber(line)
         , Kind(kind)
         , Documented(documented)
     {
     }
+
+    Location(
+        std::uint32_t file,
+        unsigned line,
+        FileKind kind = FileKind::Source,
+        bool documented = false) noexcept
+        : File(file)
+        , LineNumber(line)
+        , Kind(kind)
+        , Documented(documented)
+    {
+    }
+
+    /** Return the full file path
+    */
+    std::string_view
+    path() const noexcept
+    {
+        return FileTable::get(File).Path;
+    }
+
+    /** Return the name of the file
+    */
+    std::string_view
+    filename() const noexcept
+    {
+        return FileTable::get(File).Filename;
+    }
 };
 
 struct LocationEmptyPredicate
@@ -81,7 +149,7 @@ struct LocationEmptyPredicate
     constexpr bool operator()(
         Location const& loc) const noexcept
     {
-        return loc.Filename.empty();
+        return loc.File == 0;
     }
 };
 
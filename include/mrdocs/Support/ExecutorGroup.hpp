@@ -15,7 +15,6 @@
 #include <mrdocs/Support/any_callable.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/ThreadPool.hpp>
-#include <deque>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -26,8 +25,6 @@ namespace mrdocs {
 class MRDOCS_DECL
     ExecutorGroupBase
 {
-    class scoped_agent;
-
 protected:
     struct Impl;
 
@@ -38,13 +35,39 @@ protected:
         virtual void* get() noexcept = 0;
     };
 
+    /** Exclusive use of an idle agent for the duration of a task.
+    */
+    class agent_lock
+    {
+        ExecutorGroupBase& group_;
+        std::unique_ptr<AnyAgent> agent_;
+
+    public:
+        explicit
+        agent_lock(ExecutorGroupBase& group)
+            : group_(group)
+            , agent_(group.acquire())
+        {
+        }
+
+        ~agent_lock()
+        {
+            group_.release(std::move(agent_));
+        }
+
+        void* get() const noexcept
+        {
+            return agent_->get();
+        }
+    };
+
     std::unique_ptr<Impl> impl_;
     std::vector<std::unique_ptr<AnyAgent>> agents_;
-    std::deque<any_callable<void(void*)>> work_;
 
     explicit ExecutorGroupBase(ThreadPool&);
-    void post(any_callable<void(void*)>);
-    void run(std::unique_lock<std::mutex>);
+    void post(any_callable<void(void)>, TaskPriority);
+    std::unique_ptr<AnyAgent> acquire();
+    void release(std::unique_ptr<AnyAgent>);
 
 public:
     template<class T>
@@ -53,6 +76,29 @@ public:
     ~ExecutorGroupBase();
     ExecutorGroupBase(ExecutorGroupBase&&) noexcept;
 
+    /** Submit work which does not use an agent.
+
+        The signature of the submitted function
+        object should be `void(void)`. Errors
+        thrown from the work are returned by
+        @ref wait.
+
+        Work submitted by an agent to write out
+        its results is given a high priority, so
+        that it runs ahead of further rendering
+        and the results are released promptly.
+
+        @param priority The priority of the work.
+        @param f The function object to invoke.
+    */
+    template<class F>
+    void
+    asyncTask(TaskPriority priority, F&& f)
+    {
+        static_assert(std::is_invocable_v<F>);
+        post(std::forward<F>(f), priority);
+    }
+
     /** Block until all work has completed.
 
         @return Zero or more errors which were
@@ -123,15 +169,17 @@ public:
         static_assert(std::is_invocable_v<F, Agent&, arg_t<Args>...>);
         post(
             [
+                this,
                 f = std::forward<F>(f),
                 args = std::tuple<arg_t<Args>...>(args...)
-            ](void* agent)
+            ]() mutable
             {
+                agent_lock agent(*this);
                 std::apply(f,
                     std::tuple_cat(std::tuple<Agent&>(
-                        *reinterpret_cast<Agent*>(agent)),
+                        *reinterpret_cast<Agent*>(agent.get())),
                     std::move(args)));
-            });
+            }, TaskPriority::Normal);
     }
 };
 
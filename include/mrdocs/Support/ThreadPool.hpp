@@ -20,24 +20,46 @@
 #include <utility>
 #include <vector>
 
-namespace llvm {
-class StdThreadPool;
-class ThreadPoolTaskGroup;
-} // llvm
-
 namespace clang {
 namespace mrdocs {
 
 class TaskGroup;
 
+/** The priority of work submitted to a thread pool.
+
+    Idle threads always run queued work of
+    a higher priority before work of a lower
+    priority, regardless of submission order.
+*/
+enum class TaskPriority
+{
+    /// Short work which releases resources, such as writing files
+    High,
+    /// The default priority
+    Normal,
+    /// Work which can be deferred
+    Low
+};
+
 //------------------------------------------------
 
 /** A pool of threads for executing work concurrently.
+
+    Each thread has its own queue of work for
+    each priority. Work submitted from a thread
+    in the pool goes to the queue of that thread,
+    which runs the most recently submitted work
+    first. Other work goes to a shared queue and
+    runs in submission order. A thread whose own
+    queues are empty takes the oldest work from
+    the shared queue or from another thread.
 */
 class MRDOCS_VISIBLE
     ThreadPool
 {
-    std::unique_ptr<llvm::StdThreadPool> impl_;
+    struct Impl;
+
+    std::unique_ptr<Impl> impl_;
 
     friend class TaskGroup;
 
@@ -83,9 +105,11 @@ public:
     */
     template<class F>
     void
-    async(F&& f)
+    async(
+        F&& f,
+        TaskPriority priority = TaskPriority::Normal)
     {
-        post(std::forward<F>(f));
+        post(std::forward<F>(f), priority);
     }
 
     /** Invoke a function object for each element of a range.
@@ -105,7 +129,7 @@ public:
     wait();
 
 private:
-    MRDOCS_DECL void post(any_callable<void(void)>);
+    MRDOCS_DECL void post(any_callable<void(void)>, TaskPriority);
 };
 
 //------------------------------------------------
@@ -119,6 +143,8 @@ class MRDOCS_VISIBLE
 
     std::unique_ptr<Impl> impl_;
 
+    friend class ThreadPool;
+
 public:
     /** Destructor.
     */
@@ -126,11 +152,16 @@ public:
     ~TaskGroup();
 
     /** Constructor.
+
+        @param threadPool The pool which runs the work.
+        @param priority The priority of the work
+        submitted to the group.
     */
     MRDOCS_DECL
     explicit
     TaskGroup(
-        ThreadPool& threadPool);
+        ThreadPool& threadPool,
+        TaskPriority priority = TaskPriority::Normal);
 
     /** Submit work to be executed.
 
@@ -144,6 +175,20 @@ public:
         post(std::forward<F>(f));
     }
 
+    /** Submit work to be executed with a specific priority.
+
+        The signature of the submitted function
+        object should be `void(void)`.
+    */
+    template<class F>
+    void
+    async(
+        TaskPriority priority,
+        F&& f)
+    {
+        post(std::forward<F>(f), priority);
+    }
+
     /** Block until all work has completed.
 
         @return Zero or more errors which were
@@ -156,6 +201,7 @@ public:
 
 private:
     MRDOCS_DECL void post(any_callable<void(void)>);
+    MRDOCS_DECL void post(any_callable<void(void)>, TaskPriority);
 };
 
 //------------------------------------------------
@@ -12,7 +12,8 @@
 #define MRDOCS_API_SUPPORT_ANY_CALLABLE_HPP
 
 #include <mrdocs/Platform.hpp>
-#include <memory>
+#include <cstddef>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -21,6 +22,10 @@ namespace mrdocs {
 
 /** A movable, type-erased function object.
 
+    Function objects which are small and nothrow
+    move constructible are stored inline, without
+    a dynamic allocation.
+
     Usage:
     @code
     any_callable<void(void)> f;
@@ -32,43 +37,118 @@ class any_callable;
 template<class R, class... Args>
 class any_callable<R(Args...)>
 {
-    struct base
+    static constexpr std::size_t bufferSize = 6 * sizeof(void*);
+
+    struct vtable
     {
-        virtual ~base() = default;
-        virtual R invoke(Args&&...args) = 0;
+        R (*invoke)(void*, Args&&...);
+        void (*move)(void* dest, void* src) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<class F>
+    static constexpr bool isSmall =
+        sizeof(F) <= bufferSize &&
+        alignof(F) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+
+    template<class F>
+    static constexpr vtable smallVtable = {
+        [](void* p, Args&&... args) -> R
+        {
+            return (*static_cast<F*>(p))(std::forward<Args>(args)...);
+        },
+        [](void* dest, void* src) noexcept
+        {
+            ::new(dest) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* p) noexcept
+        {
+            static_cast<F*>(p)->~F();
+        }
+    };
+
+    template<class F>
+    static constexpr vtable largeVtable = {
+        [](void* p, Args&&... args) -> R
+        {
+            return (**static_cast<F**>(p))(std::forward<Args>(args)...);
+        },
+        [](void* dest, void* src) noexcept
+        {
+            ::new(dest) F*(*static_cast<F**>(src));
+        },
+        [](void* p) noexcept
+        {
+            delete *static_cast<F**>(p);
+        }
     };
 
-    std::unique_ptr<base> p_;
+    alignas(std::max_align_t) mutable unsigned char buf_[bufferSize];
+    vtable const* vt_ = nullptr;
 
 public:
     any_callable() = delete;
 
     template<class Callable>
-    requires std::is_invocable_r_v<R, Callable, Args...>
+    requires
+        (!std::is_same_v<std::decay_t<Callable>, any_callable>) &&
+        std::is_invocable_r_v<R, std::decay_t<Callable>&, Args...>
     any_callable(Callable&& f)
     {
-        class impl : public base
+        using F = std::decay_t<Callable>;
+        if constexpr (isSmall<F>)
         {
-            Callable f_;
+            ::new(static_cast<void*>(buf_)) F(std::forward<Callable>(f));
+            vt_ = &smallVtable<F>;
+        }
+        else
+        {
+            ::new(static_cast<void*>(buf_)) F*(
+                new F(std::forward<Callable>(f)));
+            vt_ = &largeVtable<F>;
+        }
+    }
+
+    any_callable(any_callable&& other) noexcept
+        : vt_(std::exchange(other.vt_, nullptr))
+    {
+        if (vt_)
+        {
+            vt_->move(buf_, other.buf_);
+        }
+    }
 
-        public:
-            explicit impl(Callable&& f)
-                : f_(std::forward<Callable>(f))
+    any_callable&
+    operator=(any_callable&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (vt_)
             {
+                vt_->destroy(buf_);
             }
-
-            R invoke(Args&&... args) override
+            vt_ = std::exchange(other.vt_, nullptr);
+            if (vt_)
             {
-                return f_(std::forward<Args>(args)...);
+                vt_->move(buf_, other.buf_);
             }
-        };
+        }
+        return *this;
+    }
 
-        p_ = std::make_unique<impl>(std::forward<Callable>(f));
+    ~any_callable()
+    {
+        if (vt_)
+        {
+            vt_->destroy(buf_);
+        }
     }
 
     R operator()(Args&&...args) const
     {
-        return p_->invoke(std::forward<Args>(args)...);
+        return vt_->invoke(buf_, std::forward<Args>(args)...);
     }
 };
 
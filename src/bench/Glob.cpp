@@ -0,0 +1,274 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+// Compares GlobPattern with the previous recursive
+// matchers: globMatch, used for the input file
+// patterns, and FilterPattern::matchesSlow, used
+// for the symbol filters.
+
+#include "lib/Support/Glob.hpp"
+#include <fmt/format.h>
+#include <chrono>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/** The previous implementation of globMatch.
+*/
+bool
+oldGlobMatch(
+    std::string_view pattern,
+    std::string_view str) noexcept
+{
+    if (pattern.empty())
+    {
+        return str.empty();
+    }
+    if (pattern[0] == '*')
+    {
+        if (pattern.size() == 1)
+        {
+            return true;
+        }
+        for (std::size_t i = 0; i <= str.size(); ++i)
+        {
+            if (oldGlobMatch(pattern.substr(1), str.substr(i)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (str.empty())
+    {
+        return false;
+    }
+    if (pattern[0] == str[0] || pattern[0] == '?')
+    {
+        return oldGlobMatch(pattern.substr(1), str.substr(1));
+    }
+    return false;
+}
+
+/** The previous implementation of FilterPattern.
+*/
+class OldFilterPattern
+{
+    std::string raw_;
+    std::vector<std::size_t> parts_;
+
+    bool
+    matchesSlow(
+        std::string_view str,
+        std::string_view pattern,
+        std::span<const std::size_t> parts) const
+    {
+        const auto& part = pattern.substr(0, parts[0]);
+        pattern.remove_prefix(parts[0]);
+        parts = parts.subspan(1);
+        if(! part.empty())
+        {
+            if(! str.starts_with(part))
+                return false;
+            str.remove_prefix(part.size());
+            if(parts.empty())
+                return str.empty();
+            if(parts.size() == 1)
+                return true;
+            return matchesSlow(str, pattern, parts);
+        }
+        for(; ! str.empty(); str.remove_prefix(1))
+        {
+            if(matchesSlow(str, pattern, parts))
+                return true;
+        }
+        return false;
+    }
+
+public:
+    explicit
+    OldFilterPattern(std::string_view pattern)
+    {
+        while(! pattern.empty())
+        {
+            bool wildcard = pattern.front() == '*';
+            std::size_t part_size = std::min(
+                pattern.size(), wildcard ?
+                    pattern.find_first_not_of('*') :
+                    pattern.find('*'));
+            if(! wildcard)
+                raw_.append(pattern, 0, part_size);
+            pattern.remove_prefix(part_size);
+            if(pattern.empty() && parts_.empty())
+                break;
+            parts_.push_back(wildcard ? 0 : part_size);
+        }
+    }
+
+    bool
+    matches(std::string_view str) const
+    {
+        if(parts_.empty())
+            return raw_.empty() || str == raw_;
+        if(str.size() < raw_.size())
+            return false;
+        return matchesSlow(str, raw_, parts_);
+    }
+};
+
+/** Return a set of paths resembling a source tree.
+*/
+std::vector<std::string>
+makePaths()
+{
+    static constexpr std::string_view dirs[] = {
+        "include/boost/url", "include/boost/url/detail",
+        "include/boost/url/grammar", "include/boost/url/grammar/impl",
+        "src/lib/AST", "src/lib/Support", "src/lib/Gen/html",
+        "third-party/llvm/include/llvm/ADT",
+        "third-party/llvm/include/llvm/Support",
+    };
+    static constexpr std::string_view names[] = {
+        "url_view", "segments_encoded_ref", "params_base",
+        "parse_path", "any_params_iter", "charset", "recycled",
+        "ASTVisitor", "Glob", "DenseMap", "SmallVector",
+    };
+    static constexpr std::string_view exts[] = {
+        ".hpp", ".ipp", ".cpp", ".h", ".inc",
+    };
+    std::vector<std::string> paths;
+    for(auto dir : dirs)
+        for(auto name : names)
+            for(auto ext : exts)
+                paths.push_back(fmt::format(
+                    "/home/user/project/{}/{}{}", dir, name, ext));
+    return paths;
+}
+
+/** Return a set of unqualified symbol names.
+*/
+std::vector<std::string>
+makeSymbols()
+{
+    static constexpr std::string_view stems[] = {
+        "url", "segments", "params", "encoded", "view", "ref",
+        "base", "impl", "detail", "iter", "rule", "charset",
+    };
+    std::vector<std::string> symbols;
+    for(auto a : stems)
+        for(auto b : stems)
+            for(auto c : stems)
+                symbols.push_back(fmt::format("{}_{}_{}", a, b, c));
+    return symbols;
+}
+
+template<class F>
+double
+measure(
+    std::vector<std::string> const& strs,
+    std::size_t rounds,
+    F const& f)
+{
+    std::size_t matched = 0;
+    auto const start = clock_type::now();
+    for(std::size_t i = 0; i < rounds; ++i)
+        for(auto const& s : strs)
+            matched += f(s);
+    std::chrono::duration<double> const elapsed =
+        clock_type::now() - start;
+    // keep the result observable
+    if(matched == std::size_t(-1))
+        std::abort();
+    return static_cast<double>(strs.size() * rounds) / elapsed.count();
+}
+
+void
+printResult(
+    std::string_view name,
+    double before,
+    double after)
+{
+    fmt::print("{:<32} {:>14.0f} {:>14.0f} {:>7.2f}x\n",
+        name, before, after, after / before);
+}
+
+} // (anon)
+} // mrdocs
+} // clang
+
+int
+main(int argc, char** argv)
+{
+    using namespace clang::mrdocs;
+
+    std::size_t const rounds = argc > 1 ?
+        static_cast<std::size_t>(std::atoll(argv[1])) : 200;
+
+    std::vector<std::string> const paths = makePaths();
+    std::vector<std::string> const symbols = makeSymbols();
+
+    fmt::print("{} paths, {} symbols, {} rounds (matches per second)\n",
+        paths.size(), symbols.size(), rounds);
+    fmt::print("{:<32} {:>14} {:>14} {:>8}\n",
+        "", "before", "after", "");
+
+    static constexpr std::string_view pathPatterns[] = {
+        "*.hpp",
+        "*/include/boost/*",
+        "*/detail/*.hpp",
+        "*/grammar/impl/*.?pp",
+        "/home/user/project/src/*/*.cpp",
+    };
+    for(std::string_view pattern : pathPatterns)
+    {
+        GlobPattern const glob(pattern);
+        printResult(pattern,
+            measure(paths, rounds, [&](std::string_view s)
+            {
+                return oldGlobMatch(pattern, s);
+            }),
+            measure(paths, rounds, [&](std::string_view s)
+            {
+                return glob.matches(s);
+            }));
+    }
+
+    static constexpr std::string_view symbolPatterns[] = {
+        "detail",
+        "*_impl",
+        "url_*",
+        "*_base_*",
+        "*e*e*e*",
+    };
+    for(std::string_view pattern : symbolPatterns)
+    {
+        OldFilterPattern const old(pattern);
+        GlobPattern const glob(pattern);
+        printResult(pattern,
+            measure(symbols, rounds, [&](std::string_view s)
+            {
+                return old.matches(s);
+            }),
+            measure(symbols, rounds, [&](std::string_view s)
+            {
+                return glob.matches(s);
+            }));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+// Compares the task throughput of ThreadPool
+// with the previous implementation, which posted
+// a shared_ptr to an any_callable per task to
+// an llvm::StdThreadPool.
+
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <llvm/Support/ThreadPool.h>
+#include <fmt/format.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace clang {
+namespace mrdocs {
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/** The previous implementation of TaskGroup.
+*/
+class LLVMTaskGroup
+{
+    llvm::ThreadPoolTaskGroup group_;
+
+public:
+    explicit
+    LLVMTaskGroup(llvm::StdThreadPool& pool)
+        : group_(pool)
+    {
+    }
+
+    void
+    async(any_callable<void(void)> f)
+    {
+        group_.async(
+        [sp = std::make_shared<
+            any_callable<void(void)>>(std::move(f))]
+        {
+            try
+            {
+                (*sp)();
+            }
+            catch(std::exception const&)
+            {
+            }
+        });
+    }
+
+    void
+    wait()
+    {
+        group_.wait();
+    }
+};
+
+/** Post many small independent tasks.
+*/
+template<class Group>
+void
+flat(Group& group, std::size_t tasks, std::atomic<std::size_t>& n)
+{
+    for(std::size_t i = 0; i < tasks; ++i)
+        group.async([&n]{ ++n; });
+    group.wait();
+}
+
+/** Post tasks which each post more tasks.
+*/
+template<class Group>
+void
+nested(Group& group, std::size_t tasks, std::atomic<std::size_t>& n)
+{
+    constexpr std::size_t fanout = 64;
+    for(std::size_t i = 0; i < tasks / fanout; ++i)
+    {
+        group.async(
+        [&group, &n]
+        {
+            for(std::size_t j = 0; j < fanout; ++j)
+                group.async([&n]{ ++n; });
+        });
+    }
+    group.wait();
+}
+
+template<class F>
+double
+measure(std::size_t tasks, F const& f)
+{
+    std::atomic<std::size_t> n = 0;
+    auto const start = clock_type::now();
+    f(n);
+    std::chrono::duration<double> const elapsed =
+        clock_type::now() - start;
+    if(n.load() != tasks)
+    {
+        fmt::print(stderr, "expected {} tasks, ran {}\n", tasks, n.load());
+        std::exit(EXIT_FAILURE);
+    }
+    return static_cast<double>(tasks) / elapsed.count();
+}
+
+void
+printResult(
+    std::string_view name,
+    double before,
+    double after)
+{
+    fmt::print("{:<8} {:>14.0f} {:>14.0f} {:>7.2f}x\n",
+        name, before, after, after / before);
+}
+
+} // (anon)
+} // mrdocs
+} // clang
+
+int
+main(int argc, char** argv)
+{
+    using namespace clang::mrdocs;
+
+    unsigned const threads = argc > 1 ?
+        static_cast<unsigned>(std::atoi(argv[1])) : 0;
+    std::size_t const tasks = argc > 2 ?
+        static_cast<std::size_t>(std::atoll(argv[2])) : 1000000;
+
+    llvm::ThreadPoolStrategy S;
+    S.ThreadsRequested = threads;
+    S.Limit = true;
+    llvm::StdThreadPool llvmPool(S);
+    ThreadPool pool(threads);
+
+    fmt::print("{} tasks on {} threads (tasks per second)\n",
+        tasks, pool.getThreadCount());
+    fmt::print("{:<8} {:>14} {:>14} {:>8}\n",
+        "", "before", "after", "");
+
+    printResult("flat",
+        measure(tasks, [&](auto& n)
+        {
+            LLVMTaskGroup group(llvmPool);
+            flat(group, tasks, n);
+        }),
+        measure(tasks, [&](auto& n)
+        {
+            TaskGroup group(pool);
+            flat(group, tasks, n);
+        }));
+
+    std::size_t const nestedTasks = tasks / 64 * 64;
+    printResult("nested",
+        measure(nestedTasks, [&](auto& n)
+        {
+            LLVMTaskGroup group(llvmPool);
+            nested(group, nestedTasks, n);
+        }),
+        measure(nestedTasks, [&](auto& n)
+        {
+            TaskGroup group(pool);
+            nested(group, nestedTasks, n);
+        }));
+
+    return EXIT_SUCCESS;
+}
@@ -16,7 +16,9 @@
 #include "lib/Support/Path.hpp"
 #include "lib/Support/Debug.hpp"
 #include "lib/Support/Glob.hpp"
+#include "lib/Support/Stats.hpp"
 #include "lib/Lib/Diagnostics.hpp"
+#include "lib/Lib/ExtractionRegistry.hpp"
 #include "lib/Lib/Filters.hpp"
 #include "lib/Lib/Info.hpp"
 #include <mrdocs/Metadata.hpp>
@@ -34,12 +36,15 @@
 #include <clang/Sema/Template.h>
 #include <clang/Sema/SemaConsumer.h>
 #include <clang/Sema/TemplateInstCallback.h>
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/Hashing.h>
 #include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/Support/Error.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/SHA1.h>
+#include <llvm/Support/xxhash.h>
+#include <array>
 #include <memory>
 #include <optional>
 #include <ranges>
@@ -193,17 +198,48 @@ public:
         std::string full_path;
         std::string_view short_path;
         FileKind kind;
+
+        // the index of the file in the FileTable
+        std::uint32_t file = 0;
+
+        // whether declarations in the file satisfy
+        // the input include prefixes and file patterns
+        bool matchesInput = true;
     };
 
     std::unordered_map<
         const FileEntry*,
         FileInfo> files_;
 
+    // the file of each FileID seen in a location,
+    // or nullptr if it is not a known file
+    llvm::DenseMap<FileID, FileInfo*> fileIDs_;
+
+    // the normalized source root and include
+    // search directories, used to build FileInfo
+    std::string sourceRoot_;
+    std::vector<std::pair<std::string, FileKind>> searchDirs_;
+
     llvm::SmallString<128> usr_;
     ODRHash odr_hash_;
 
+    // the symbol ID of each declaration, computed once
+    llvm::DenseMap<const Decl*, SymbolID> symbolIDs_;
+
+    // definitions extracted by other translation units,
+    // and those extracted completely by this one
+    ExtractionRegistry* registry_;
+    std::vector<ExtractionRegistry::Definition> extracted_;
+    std::size_t skipped_ = 0;
+
     SymbolFilter symbolFilter_;
 
+    // time spent in each pass of build()
+    Stats::duration traverseTime_{};
+    Stats::duration dependenciesTime_{};
+    // time spent computing symbol IDs
+    Stats::duration symbolIDTime_{};
+
     enum class ExtractMode
     {
         // extraction of declarations which pass all filters
@@ -255,7 +291,8 @@ public:
         Diagnostics& diags,
         CompilerInstance& compiler,
         ASTContext& context,
-        Sema& sema) noexcept
+        Sema& sema,
+        ExtractionRegistry* registry) noexcept
         : config_(config)
         , diags_(diags)
         , compiler_(compiler)
@@ -263,6 +300,7 @@ public:
         , source_(context.getSourceManager())
         , sema_(sema)
         , symbolFilter_(config->symbolFilter)
+        , registry_(registry)
     {
         // install handlers for our custom commands
         initCustomCommentCommands(context_);
@@ -274,34 +312,12 @@ public:
         MRDOCS_ASSERT(context_.getTraversalScope() ==
             std::vector<Decl*>{context_.getTranslationUnitDecl()});
 
-        using namespace llvm::sys;
         Preprocessor& PP = sema_.getPreprocessor();
         HeaderSearch& HS = PP.getHeaderSearchInfo();
 
-        auto normalize_path = [&](std::string_view old_path)
-        {
-            llvm::SmallString<128> new_path(old_path);
-            // KRYSTIAN FIXME: use FileManager::makeAbsolutePath?
-            if(! path::is_absolute(new_path))
-            {
-                auto& cwd = source_.getFileManager().
-                    getFileSystemOpts().WorkingDir;
-                // we can't normalize a relative path
-                // without a base directory
-                // MRDOCS_ASSERT(! cwd.empty());
-                fs::make_absolute(cwd, new_path);
-            }
-            // remove ./ and ../
-            path::remove_dots(new_path, true, path::Style::posix);
-            // convert to posix style
-            path::native(new_path, path::Style::posix);
-            return std::string(new_path);
-        };
+        sourceRoot_ = normalizePath(config_->sourceRoot);
 
-        std::string sourceRoot = normalize_path(config_->sourceRoot);
-        std::vector<std::pair<std::string, FileKind>> search_dirs;
-
-        search_dirs.reserve(HS.search_dir_size());
+        searchDirs_.reserve(HS.search_dir_size());
         // first, convert all the include search directories into POSIX style
         for(const DirectoryLookup& DL : HS.search_dir_range())
         {
@@ -310,32 +326,59 @@ public:
             if(! DL.isNormalDir() || ! DR)
                 continue;
             // store the normalized path
-            search_dirs.emplace_back(
-                normalize_path(DR->getName()),
+            searchDirs_.emplace_back(
+                normalizePath(DR->getName()),
                 DL.isSystemHeaderDirectory() ?
                     FileKind::System : FileKind::Other);
         }
 
-        auto build_file_info = [&](const FileEntry* file)
-        {
-            // "try" implies this may fail, so fallback to getName
-            // if an empty string is returned
-            std::string_view file_path =
-                file->tryGetRealPathName();
-            files_.emplace(file,
-                getFileInfo(search_dirs,
-                    normalize_path(file_path),
-                    sourceRoot));
-        };
-
         // build the file info for the main file
-        build_file_info(
+        buildFileInfo(
             source_.getFileEntryForID(
                 source_.getMainFileID()));
 
         // build the file info for all included files
         for(const FileEntry* file : PP.getIncludedFiles())
-            build_file_info(file);
+            buildFileInfo(file);
+    }
+
+    std::string
+    normalizePath(std::string_view old_path)
+    {
+        using namespace llvm::sys;
+        llvm::SmallString<128> new_path(old_path);
+        // KRYSTIAN FIXME: use FileManager::makeAbsolutePath?
+        if(! path::is_absolute(new_path))
+        {
+            auto& cwd = source_.getFileManager().
+                getFileSystemOpts().WorkingDir;
+            // we can't normalize a relative path
+            // without a base directory
+            // MRDOCS_ASSERT(! cwd.empty());
+            fs::make_absolute(cwd, new_path);
+        }
+        // remove ./ and ../
+        path::remove_dots(new_path, true, path::Style::posix);
+        // convert to posix style
+        path::native(new_path, path::Style::posix);
+        return std::string(new_path);
+    }
+
+    FileInfo*
+    buildFileInfo(const FileEntry* file)
+    {
+        // "try" implies this may fail, so fallback to getName
+        // if an empty string is returned
+        std::string_view file_path =
+            file->tryGetRealPathName();
+        FileInfo file_info = getFileInfo(searchDirs_,
+            normalizePath(file_path),
+            sourceRoot_);
+        file_info.matchesInput = matchesInput(file_info.full_path);
+        file_info.file = FileTable::intern(
+            file_info.full_path, file_info.short_path);
+        return &files_.try_emplace(
+            file, std::move(file_info)).first->second;
     }
 
     FileInfo
@@ -416,10 +459,12 @@ public:
         // traverse the translation unit, only extracting
         // declarations which satisfy all filter conditions.
         // dependencies will be tracked, but not extracted
+        Stats::Timer traverseTimer;
         traverseDecl(context_.getTranslationUnitDecl());
 
         // This is to ensure that the global namespace is always present
         getOrCreateInfo<NamespaceInfo>(SymbolID::global);
+        traverseTime_ = traverseTimer.elapsed();
 
         // if dependency extraction is disabled, we are done
         if(config_->referencedDeclarations ==
@@ -430,8 +475,10 @@ public:
         // and generate a new set based on the results.
         // if the new set is non-empty, perform another pass.
         // do this until no new dependencies are generated
+        Stats::Timer dependenciesTimer;
         std::unordered_set<Decl*> previous;
         buildDependencies(previous);
+        dependenciesTime_ = dependenciesTimer.elapsed();
     }
 
     void buildDependencies(
@@ -719,7 +766,11 @@ public:
         To guarantee the uniqueness of symbols while using
         a relatively small amount of memory (vs storing
         USRs directly), this function hashes the Decl
-        USR value with SHA1.
+        USR value with SHA1, or with XXH3 when the
+        `symbol-id-hash` option is `xxh3`.
+
+        The same declaration is referenced many times,
+        so the result is memoized per declaration.
 
         @return true if the symbol ID could not be
         extracted, and false otherwise.
@@ -737,14 +788,47 @@ public:
             id = SymbolID::global;
             return true;
         }
-        usr_.clear();
-        if(generateUSR(D))
+        auto [it, inserted] = symbolIDs_.try_emplace(D, SymbolID::invalid);
+        if(inserted)
+        {
+            Stats::Timer timer;
+            usr_.clear();
+            if(! generateUSR(D))
+                it->second = hashUSR(usr_);
+            symbolIDTime_ += timer.elapsed();
+        }
+        if(! it->second)
             return false;
-        auto h = llvm::SHA1::hash(arrayRefFromStringRef(usr_));
-        id = SymbolID(h.data());
+        id = it->second;
         return true;
     }
 
+    /** Return the symbol ID for a USR.
+    */
+    SymbolID
+    hashUSR(llvm::StringRef usr) const
+    {
+        if(config_->symbolIdHash ==
+            ConfigImpl::SettingsImpl::SymbolIdHash::Xxh3)
+        {
+            // 128 bits from XXH3-128 and 32 bits from XXH3-64
+            auto const bytes = arrayRefFromStringRef(usr);
+            llvm::XXH128_hash_t const h128 = llvm::xxh3_128bits(bytes);
+            std::uint64_t const h64 = llvm::xxh3_64bits(bytes);
+            std::array<std::uint8_t, 20> data;
+            for(std::size_t i = 0; i < 8; ++i)
+            {
+                data[i] = static_cast<std::uint8_t>(h128.low64 >> (8 * i));
+                data[8 + i] = static_cast<std::uint8_t>(h128.high64 >> (8 * i));
+            }
+            for(std::size_t i = 0; i < 4; ++i)
+                data[16 + i] = static_cast<std::uint8_t>(h64 >> (8 * i));
+            return SymbolID(data.data());
+        }
+        auto h = llvm::SHA1::hash(arrayRefFromStringRef(usr));
+        return SymbolID(h.data());
+    }
+
     /** Extracts the symbol ID for a declaration.
 
         This function will extract the symbol ID for a
@@ -772,6 +856,61 @@ public:
 
     //------------------------------------------------
 
+    /** Return the definition a declaration shares with other translation units.
+
+        Only definitions of records and enums outside
+        the main file are shared, since their members
+        account for most of the work of each header.
+
+        @return the definition, or std::nullopt if the
+        declaration is not a shared definition.
+    */
+    template<std::derived_from<TagDecl> TagTy>
+    std::optional<ExtractionRegistry::Definition>
+    getSharedDefinition(TagTy* D)
+    {
+        if(! registry_ ||
+            ! D->isThisDeclarationADefinition() ||
+            source_.isInMainFile(D->getLocation()))
+            return std::nullopt;
+        // the ODR hash does not reflect the contents
+        // of class template specializations
+        for(DeclContext* DC = D; DC; DC = DC->getParent())
+        {
+            if(isa<ClassTemplateSpecializationDecl>(DC))
+                return std::nullopt;
+        }
+        SymbolID id;
+        if(! extractSymbolID(D, id))
+            return std::nullopt;
+        return ExtractionRegistry::Definition(id, D->getODRHash());
+    }
+
+    /** Return true if a definition was extracted by another translation unit.
+    */
+    bool
+    isExtractedElsewhere(
+        std::optional<ExtractionRegistry::Definition> const& def)
+    {
+        if(! def || ! registry_->contains(*def))
+            return false;
+        ++skipped_;
+        return true;
+    }
+
+    /** Record a definition this translation unit extracted completely.
+    */
+    void
+    addExtracted(
+        std::optional<ExtractionRegistry::Definition> const& def)
+    {
+        // definitions extracted as dependencies may be incomplete
+        if(def && currentMode() == ExtractMode::Normal)
+            extracted_.push_back(*def);
+    }
+
+    //------------------------------------------------
+
     AccessSpecifier
     getAccess(const Decl* D)
     {
@@ -838,28 +977,64 @@ public:
     // type named "SourceLocation"...
     FileInfo* getFileInfo(clang::SourceLocation loc)
     {
-        // KRYSTIAN FIXME: we really should not be
-        // calling getPresumedLoc this often,
-        // it's quite expensive
-        auto presumed = source_.getPresumedLoc(loc, false);
-        if(presumed.isInvalid())
+        if(loc.isInvalid())
             return nullptr;
+        // ignoring line directives, the presumed location
+        // is in the file of the expansion location.
+        // the result is memoized per FileID, since
+        // getPresumedLoc is quite expensive
+        FileID id = source_.getFileID(
+            source_.getExpansionLoc(loc));
+        auto [cached, inserted] = fileIDs_.try_emplace(id, nullptr);
+        if(! inserted)
+            return cached->second;
         const FileEntry* file =
-            source_.getFileEntryForID(
-                presumed.getFileID());
+            source_.getFileEntryForID(id);
         // KRYSTIAN NOTE: i have no idea under what
         // circumstances the file entry would be null
         if(! file)
             return nullptr;
-        // KRYSTIAN NOTE: i have no idea under what
-        // circumstances the file would not be in either
-        // the main file, or an included file
+        // headers loaded from a precompiled header
+        // are not reported as included files
         auto it = files_.find(file);
         if(it == files_.end())
-            return nullptr;
+            return cached->second = buildFileInfo(file);
+        cached->second = &it->second;
         return &it->second;
     }
 
+    /** Return true if a file satisfies the input filters
+
+        The file must start with one of the input
+        include prefixes, and match one of the input
+        file patterns, when these are specified.
+    */
+    bool
+    matchesInput(std::string_view filename) const
+    {
+        if (!config_->input.include.empty() &&
+            !std::ranges::any_of(
+                config_->input.include,
+                [&filename](const std::string& prefix)
+                {
+                    return files::startsWith(filename, prefix);
+                }))
+        {
+            return false;
+        }
+        if (!config_->filePatternFilter.empty() &&
+            !std::ranges::any_of(
+                config_->filePatternFilter,
+                [&filename](const GlobPattern& pattern)
+                {
+                    return pattern.matches(filename);
+                }))
+        {
+            return false;
+        }
+        return true;
+    }
+
     /** Add a source location to an Info object.
 
         This function will add a source location to an Info,
@@ -885,9 +1060,8 @@ public:
         {
             if(I.DefLoc)
                 return;
-            I.DefLoc.emplace(file->full_path,
-                file->short_path, line, file->kind,
-                documented);
+            I.DefLoc.emplace(file->file,
+                line, file->kind, documented);
         }
         else
         {
@@ -895,13 +1069,12 @@ public:
                 [line, file](const Location& l)
                 {
                     return l.LineNumber == line &&
-                        l.Path == file->full_path;
+                        l.File == file->file;
                 });
             if(existing != I.Loc.end())
                 return;
-            I.Loc.emplace_back(file->full_path,
-                file->short_path, line, file->kind,
-                documented);
+            I.Loc.emplace_back(file->file,
+                line, file->kind, documented);
         }
     }
 
@@ -1519,39 +1692,12 @@ public:
                 return false;
         }
 
-        if (!config_->input.include.empty())
+        if (!config_->input.include.empty() ||
+            !config_->filePatternFilter.empty())
         {
-            // Get filename
+            // The verdict is computed once per file
             FileInfo* file = getFileInfo(D->getBeginLoc());
-            if (!file)
-                return false;
-            std::string filename = file->full_path;
-            bool matchPrefix = std::ranges::any_of(
-                config_->input.include,
-                [&filename](const std::string& prefix)
-                {
-                    return files::startsWith(filename, prefix);
-                });
-            if (!matchPrefix)
-            {
-                return false;
-            }
-        }
-
-        if (!config_->input.filePatterns.empty())
-        {
-            // Get filename
-            FileInfo* file = getFileInfo(D->getBeginLoc());
-            if (!file)
-                return false;
-            std::string filename = file->full_path;
-            bool matchPattern = std::ranges::any_of(
-                config_->input.filePatterns,
-                [&filename](const std::string& pattern)
-                {
-                    return globMatch(pattern, filename);
-                });
-            if (!matchPattern)
+            if (!file || !file->matchesInput)
             {
                 return false;
             }
@@ -3046,11 +3192,16 @@ void
 ASTVisitor::
 traverse(EnumDecl* D)
 {
+    auto def = getSharedDefinition(D);
+    if(isExtractedElsewhere(def))
+        return;
+
     auto exp = upsertMrDocsInfoFor(D);
     if(! exp) { return; }
     auto [I, created] = *exp;
     buildEnum(I, created, D);
     traverseContext(D);
+    addExtracted(def);
 }
 
 //------------------------------------------------
@@ -3168,6 +3319,10 @@ traverse(
     CXXRecordTy* D,
     ClassTemplateDecl* CTD)
 {
+    auto def = getSharedDefinition(D);
+    if(isExtractedElsewhere(def))
+        return;
+
     auto exp = upsertMrDocsInfoFor(D);
     if(! exp) { return; }
     auto [I, created] = *exp;
@@ -3197,6 +3352,7 @@ traverse(
 
     buildRecord(I, created, D);
     traverseContext(D);
+    addExtracted(def);
 }
 
 template<std::derived_from<VarDecl> VarTy>
@@ -4563,6 +4719,8 @@ class ASTVisitorConsumer
     const ConfigImpl& config_;
     ExecutionContext& ex_;
     CompilerInstance& compiler_;
+    Stats::TranslationUnit& stats_;
+    ExtractionRegistry* registry_;
 
     Sema* sema_ = nullptr;
 
@@ -4609,22 +4767,47 @@ class ASTVisitorConsumer
 
         // skip the translation unit if configured to do so
         convert_to_slash(*file_name);
+        stats_.file = file_name->str();
 
         ASTVisitor visitor(
             config_,
             diags,
             compiler_,
             Context,
-            *sema_);
+            *sema_,
+            registry_);
 
         // Traverse the translation unit
         visitor.build();
+        stats_.traverse = visitor.traverseTime_;
+        stats_.dependencies = visitor.dependenciesTime_;
+        stats_.symbolIds = visitor.symbolIDTime_;
+
+        // Report the main file and every included file
+        std::vector<std::string> files;
+        files.reserve(visitor.files_.size());
+        for (auto const& [entry, info] : visitor.files_)
+        {
+            files.push_back(info.full_path);
+        }
+        ex_.reportFiles(files);
 
         // VFALCO If we returned from the function early
         // then this line won't execute, which means we
         // will miss error and warnings emitted before
         // the return.
+        Stats::Timer queueTimer;
         ex_.report(std::move(visitor.results()), std::move(diags));
+        stats_.queueWait = queueTimer.elapsed();
+
+        // Publish the definitions once they are part
+        // of the results, so other translation units
+        // can skip them
+        if (registry_)
+        {
+            registry_->insert(visitor.extracted_);
+            registry_->addSkipped(visitor.skipped_);
+        }
     }
 
     /** Skip function bodies
@@ -4686,10 +4869,14 @@ public:
     ASTVisitorConsumer(
         const ConfigImpl& config,
         ExecutionContext& ex,
-        CompilerInstance& compiler) noexcept
+        CompilerInstance& compiler,
+        Stats::TranslationUnit& stats,
+        ExtractionRegistry* registry) noexcept
         : config_(config)
         , ex_(ex)
         , compiler_(compiler)
+        , stats_(stats)
+        , registry_(registry)
     {
     }
 };
@@ -4713,9 +4900,11 @@ struct ASTAction
 {
     ASTAction(
         ExecutionContext& ex,
-        ConfigImpl const& config) noexcept
+        ConfigImpl const& config,
+        ExtractionRegistry* registry) noexcept
         : ex_(ex)
         , config_(config)
+        , registry_(registry)
     {
     }
 
@@ -4741,6 +4930,10 @@ struct ASTAction
             return;
         }
 
+        // Everything since the action was created was
+        // spent setting up the compiler and preprocessor
+        stats_.preprocess = timer_.elapsed();
+
         // Ensure comments in system headers are retained.
         // We may want them if, e.g., a declaration was extracted
         // as a dependency
@@ -4751,10 +4944,24 @@ struct ASTAction
             CI.createSema(getTranslationUnitKind(), nullptr);
         }
 
+        Stats::Timer parseTimer;
         ParseAST(
             CI.getSema(),
             false, // ShowStats
             true); // SkipFunctionBodies
+
+        // Preprocessing is interleaved with parsing,
+        // so the time spent lexing is included here
+        stats_.parse = parseTimer.elapsed() - stats_.traverse -
+            stats_.dependencies - stats_.queueWait;
+
+        // A translation unit which failed is parsed
+        // again, or reported as an error, so only
+        // a successful parse is recorded
+        if (!CI.getDiagnostics().hasErrorOccurred())
+        {
+            Stats::get().addTranslationUnit(std::move(stats_));
+        }
     }
 
     /** Create the object that will traverse the AST
@@ -4776,12 +4983,15 @@ struct ASTAction
         llvm::StringRef InFile) override
     {
         return std::make_unique<ASTVisitorConsumer>(
-            config_, ex_, Compiler);
+            config_, ex_, Compiler, stats_, registry_);
     }
 
 private:
     ExecutionContext& ex_;
     ConfigImpl const& config_;
+    ExtractionRegistry* registry_;
+    Stats::Timer timer_;
+    Stats::TranslationUnit stats_;
 };
 
 //------------------------------------------------
@@ -4796,21 +5006,24 @@ struct ASTActionFactory :
 {
     ASTActionFactory(
         ExecutionContext& ex,
-        ConfigImpl const& config) noexcept
+        ConfigImpl const& config,
+        ExtractionRegistry* registry) noexcept
         : ex_(ex)
         , config_(config)
+        , registry_(registry)
     {
     }
 
     std::unique_ptr<FrontendAction>
     create() override
     {
-        return std::make_unique<ASTAction>(ex_, config_);
+        return std::make_unique<ASTAction>(ex_, config_, registry_);
     }
 
 private:
     ExecutionContext& ex_;
     ConfigImpl const& config_;
+    ExtractionRegistry* registry_;
 };
 
 } // (anon)
@@ -4820,9 +5033,10 @@ private:
 std::unique_ptr<tooling::FrontendActionFactory>
 makeFrontendActionFactory(
     ExecutionContext& ex,
-    ConfigImpl const& config)
+    ConfigImpl const& config,
+    ExtractionRegistry* registry)
 {
-    return std::make_unique<ASTActionFactory>(ex, config);
+    return std::make_unique<ASTActionFactory>(ex, config, registry);
 }
 
 } // mrdocs
@@ -15,6 +15,7 @@
 
 #include "lib/Lib/ConfigImpl.hpp"
 #include "lib/Lib/ExecutionContext.hpp"
+#include "lib/Lib/ExtractionRegistry.hpp"
 #include <mrdocs/Platform.hpp>
 #include <clang/Tooling/Tooling.h>
 
@@ -22,11 +23,16 @@ namespace clang {
 namespace mrdocs {
 
 /** Return a factory used to create our visitor.
+
+    @param registry If not null, definitions already
+    extracted by other translation units are skipped,
+    and the definitions extracted are added to it.
 */
 std::unique_ptr<tooling::FrontendActionFactory>
 makeFrontendActionFactory(
     ExecutionContext& ex,
-    ConfigImpl const& config);
+    ConfigImpl const& config,
+    ExtractionRegistry* registry = nullptr);
 
 } // mrdocs
 } // clang
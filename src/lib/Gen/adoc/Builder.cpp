@@ -10,6 +10,7 @@
 
 #include "Builder.hpp"
 #include "lib/Support/Radix.hpp"
+#include "lib/Support/Stats.hpp"
 #include <lib/Lib/ConfigImpl.hpp>
 #include <mrdocs/Metadata/DomMetadata.hpp>
 #include <mrdocs/Support/Path.hpp>
@@ -139,8 +140,10 @@ callTemplate(
     MRDOCS_TRY(auto fileText, files::getFileText(pathName));
     HandlebarsOptions options;
     options.noEscape = true;
+    Stats::Timer timer;
     Expected<std::string, HandlebarsError> exp =
         hbs_.try_render(fileText, context, options);
+    Stats::get().addRender("adoc", name, timer.elapsed());
     if (!exp)
     {
         return Unexpected(Error(exp.error().what()));
@@ -193,6 +196,7 @@ createContext(
     props.emplace_back("config", domCorpus->config.object());
     props.emplace_back("sectionref",
         domCorpus.names_.getQualified(I.id, '-'));
+    props.emplace_back("indexes", domCorpus.getIndexes());
     return dom::Object(std::move(props));
 }
 
@@ -209,6 +213,7 @@ createContext(
         getRelPrefix(Parent.Namespace.size() + 1));
     props.emplace_back("sectionref",
         domCorpus.names_.getQualified(OS, '-'));
+    props.emplace_back("indexes", domCorpus.getIndexes());
     return dom::Object(std::move(props));
 }
 
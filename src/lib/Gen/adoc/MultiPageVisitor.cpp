@@ -9,6 +9,7 @@
 //
 
 #include "MultiPageVisitor.hpp"
+#include "lib/Support/Stats.hpp"
 #include <mrdocs/Support/Path.hpp>
 #include <fstream>
 
@@ -36,6 +37,7 @@ writePage(
                 std::ios_base::trunc // | std::ios_base::noreplace
             );
         os.write(text.data(), text.size());
+        Stats::get().addBytesWritten(text.size());
     }
     catch(std::exception const& ex)
     {
@@ -50,10 +52,14 @@ operator()(T const& I)
 {
     ex_.async([this, &I](Builder& builder)
     {
-        if(const auto r = builder(I))
-            writePage(*r, builder.domCorpus.getXref(I));
-        else
+        auto r = builder(I);
+        if(! r)
             r.error().Throw();
+        ex_.asyncTask(TaskPriority::High,
+            [this, text = std::move(*r), filename = builder.domCorpus.getXref(I)]
+            {
+                writePage(text, filename);
+            });
         if constexpr(
                 T::isNamespace() ||
                 T::isRecord() ||
@@ -71,10 +77,14 @@ operator()(OverloadSet const& OS)
 {
     ex_.async([this, OS](Builder& builder)
     {
-        if(const auto r = builder(OS))
-            writePage(*r, builder.domCorpus.getXref(OS));
-        else
+        auto r = builder(OS);
+        if(! r)
             r.error().Throw();
+        ex_.asyncTask(TaskPriority::High,
+            [this, text = std::move(*r), filename = builder.domCorpus.getXref(OS)]
+            {
+                writePage(text, filename);
+            });
         corpus_.traverse(OS, *this);
     });
 }
@@ -10,6 +10,7 @@
 
 #include "Builder.hpp"
 #include "lib/Support/Radix.hpp"
+#include "lib/Support/Stats.hpp"
 #include <mrdocs/Metadata/DomMetadata.hpp>
 #include <mrdocs/Support/Path.hpp>
 #include <llvm/Support/FileSystem.h>
@@ -144,8 +145,10 @@ callTemplate(
     MRDOCS_TRY(auto fileText, files::getFileText(pathName));
     HandlebarsOptions options;
     options.noEscape = true;
+    Stats::Timer timer;
     Expected<std::string, HandlebarsError> exp =
         hbs_.try_render(fileText, context, options);
+    Stats::get().addRender("html", name, timer.elapsed());
     if (!exp)
     {
         return Unexpected(Error(exp.error().what()));
@@ -189,7 +192,8 @@ createContext(
     SymbolID const& id)
 {
     return dom::Object({
-        { "symbol", domCorpus_.get(id) }
+        { "symbol", domCorpus_.get(id) },
+        { "indexes", domCorpus_.getIndexes() }
         });
 }
 
@@ -204,6 +208,7 @@ createContext(
     const Info& Parent = domCorpus_->get(OS.Parent);
     props.emplace_back("relfileprefix",
         getRelPrefix(Parent.Namespace.size() + 1));
+    props.emplace_back("indexes", domCorpus_.getIndexes());
     return dom::Object(std::move(props));
 }
 
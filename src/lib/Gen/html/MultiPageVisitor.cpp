@@ -9,6 +9,7 @@
 //
 
 #include "MultiPageVisitor.hpp"
+#include "lib/Support/Stats.hpp"
 #include <mrdocs/Support/Path.hpp>
 #include <fstream>
 
@@ -39,22 +40,26 @@ renderPage(
         {
             auto pageText = builder(I).value();
 
-            std::string fileName = files::appendPath(
-                outputPath_, toBase16(I.id) + ".html");
-            std::ofstream os;
-            try
-            {
-                os.open(fileName,
-                    std::ios_base::binary |
-                        std::ios_base::out |
-                        std::ios_base::trunc // | std::ios_base::noreplace
-                    );
-                os.write(pageText.data(), pageText.size());
-            }
-            catch(std::exception const& ex)
-            {
-                formatError("std::ofstream(\"{}\") threw \"{}\"", fileName, ex.what()).Throw();
-            }
+            ex_.asyncTask(TaskPriority::High,
+                [pageText = std::move(pageText), fileName = files::appendPath(
+                    outputPath_, toBase16(I.id) + ".html")]
+                {
+                    std::ofstream os;
+                    try
+                    {
+                        os.open(fileName,
+                            std::ios_base::binary |
+                                std::ios_base::out |
+                                std::ios_base::trunc // | std::ios_base::noreplace
+                            );
+                        os.write(pageText.data(), pageText.size());
+                        Stats::get().addBytesWritten(pageText.size());
+                    }
+                    catch(std::exception const& ex)
+                    {
+                        formatError("std::ofstream(\"{}\") threw \"{}\"", fileName, ex.what()).Throw();
+                    }
+                });
         });
 }
 
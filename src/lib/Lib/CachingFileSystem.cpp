@@ -0,0 +1,228 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "CachingFileSystem.hpp"
+#include <llvm/ADT/SmallString.h>
+#include <functional>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+/** A file whose contents are owned by the shared cache.
+*/
+class CachedFile
+    : public llvm::vfs::File
+{
+    llvm::vfs::Status status_;
+    SharedFileSystemCache::Contents const& contents_;
+
+public:
+    CachedFile(
+        llvm::vfs::Status status,
+        SharedFileSystemCache::Contents const& contents)
+        : status_(std::move(status))
+        , contents_(contents)
+    {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status>
+    status() override
+    {
+        return status_;
+    }
+
+    // The name of the underlying file, in which the
+    // FileManager finds the real path of the file
+    llvm::ErrorOr<std::string>
+    getName() override
+    {
+        return contents_.name;
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+    getBuffer(
+        llvm::Twine const& Name,
+        std::int64_t,
+        bool RequiresNullTerminator,
+        bool) override
+    {
+        // The cached buffer is always null-terminated
+        return llvm::MemoryBuffer::getMemBuffer(
+            contents_.buffer->getBuffer(), Name.str(),
+            RequiresNullTerminator);
+    }
+
+    std::error_code
+    close() override
+    {
+        return {};
+    }
+};
+
+/** A file system with its own working directory over a shared cache.
+
+    The underlying file system keeps the working
+    directory; paths are made absolute before they
+    are looked up in the cache.
+*/
+class CachingFileSystem
+    : public llvm::vfs::ProxyFileSystem
+{
+    SharedFileSystemCache& cache_;
+
+    llvm::ErrorOr<std::string>
+    absolutePath(llvm::Twine const& path)
+    {
+        llvm::SmallString<256> abs;
+        path.toVector(abs);
+        if (auto ec = makeAbsolute(abs))
+        {
+            return ec;
+        }
+        return std::string(abs);
+    }
+
+public:
+    CachingFileSystem(
+        SharedFileSystemCache& cache,
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs)
+        : ProxyFileSystem(std::move(fs))
+        , cache_(cache)
+    {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status>
+    status(llvm::Twine const& path) override
+    {
+        auto abs = absolutePath(path);
+        if (!abs)
+        {
+            return ProxyFileSystem::status(path);
+        }
+        auto st = cache_.status(*abs, getUnderlyingFS());
+        if (!st)
+        {
+            return st;
+        }
+        // Report the path as it was requested
+        return llvm::vfs::Status::copyWithNewName(*st, path);
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+    openFileForRead(llvm::Twine const& path) override
+    {
+        auto abs = absolutePath(path);
+        if (!abs)
+        {
+            return ProxyFileSystem::openFileForRead(path);
+        }
+        auto st = cache_.status(*abs, getUnderlyingFS());
+        if (!st)
+        {
+            return st.getError();
+        }
+        // Only regular files are cached
+        if (!st->isRegularFile())
+        {
+            return ProxyFileSystem::openFileForRead(path);
+        }
+        auto contents = cache_.contents(*abs, getUnderlyingFS());
+        if (!contents)
+        {
+            return contents.getError();
+        }
+        return std::make_unique<CachedFile>(
+            llvm::vfs::Status::copyWithNewName(*st, path),
+            **contents);
+    }
+};
+
+} // (anon)
+
+SharedFileSystemCache::Shard&
+SharedFileSystemCache::
+shard(std::string const& path) noexcept
+{
+    return shards_[std::hash<std::string>()(path) % shardCount];
+}
+
+llvm::ErrorOr<llvm::vfs::Status>
+SharedFileSystemCache::
+status(
+    std::string const& path,
+    llvm::vfs::FileSystem& fs)
+{
+    Shard& s = shard(path);
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (auto it = s.status.find(path); it != s.status.end())
+        {
+            ++statusHits_;
+            return it->second;
+        }
+    }
+    ++statusMisses_;
+    // Failures are cached too, since most lookups
+    // are for headers in the wrong include directory
+    auto st = fs.status(path);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.status.try_emplace(path, std::move(st)).first->second;
+}
+
+auto
+SharedFileSystemCache::
+contents(
+    std::string const& path,
+    llvm::vfs::FileSystem& fs) ->
+        llvm::ErrorOr<Contents const*>
+{
+    Shard& s = shard(path);
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (auto it = s.contents.find(path); it != s.contents.end())
+        {
+            ++contentHits_;
+            return it->second.get();
+        }
+    }
+    ++contentMisses_;
+    auto file = fs.openFileForRead(path);
+    if (!file)
+    {
+        return file.getError();
+    }
+    auto name = (*file)->getName();
+    if (!name)
+    {
+        return name.getError();
+    }
+    auto buffer = (*file)->getBuffer(path, -1, true, false);
+    if (!buffer)
+    {
+        return buffer.getError();
+    }
+    auto contents = std::make_unique<Contents>(
+        Contents{ std::move(*buffer), std::move(*name) });
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.contents.try_emplace(
+        path, std::move(contents)).first->second.get();
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>
+createCachingFileSystem(SharedFileSystemCache& cache)
+{
+    return llvm::makeIntrusiveRefCnt<CachingFileSystem>(
+        cache, llvm::vfs::createPhysicalFileSystem());
+}
+
+} // mrdocs
+} // clang
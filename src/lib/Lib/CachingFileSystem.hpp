@@ -0,0 +1,119 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_CACHINGFILESYSTEM_HPP
+#define MRDOCS_LIB_LIB_CACHINGFILESYSTEM_HPP
+
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace clang {
+namespace mrdocs {
+
+/** File status and contents shared by all translation units.
+
+    Every translation unit stats and reads mostly
+    the same headers. This cache memoizes the status
+    of each absolute path, including failures, and
+    the contents of each file, which are memory
+    mapped read-only when they are large enough.
+
+    Files are assumed not to change while
+    declarations are being extracted.
+*/
+class SharedFileSystemCache
+{
+public:
+    /** Return the status of an absolute path.
+
+        @param fs The file system used on a miss.
+    */
+    llvm::ErrorOr<llvm::vfs::Status>
+    status(
+        std::string const& path,
+        llvm::vfs::FileSystem& fs);
+
+    /** The contents of a file.
+    */
+    struct Contents
+    {
+        /** The null-terminated contents of the file.
+        */
+        std::unique_ptr<llvm::MemoryBuffer> buffer;
+
+        /** The name of the file, as reported by the file system.
+
+            For a physical file system, symbolic
+            links are resolved in this name.
+        */
+        std::string name;
+    };
+
+    /** Return the contents of an absolute path.
+
+        The contents live as long as the cache.
+
+        @param fs The file system used on a miss.
+    */
+    llvm::ErrorOr<Contents const*>
+    contents(
+        std::string const& path,
+        llvm::vfs::FileSystem& fs);
+
+    std::uint64_t statusHits() const noexcept { return statusHits_; }
+    std::uint64_t statusMisses() const noexcept { return statusMisses_; }
+    std::uint64_t contentHits() const noexcept { return contentHits_; }
+    std::uint64_t contentMisses() const noexcept { return contentMisses_; }
+
+private:
+    static constexpr std::size_t shardCount = 64;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string,
+            llvm::ErrorOr<llvm::vfs::Status>> status;
+        std::unordered_map<std::string,
+            std::unique_ptr<Contents>> contents;
+    };
+
+    std::array<Shard, shardCount> shards_;
+    std::atomic<std::uint64_t> statusHits_ = 0;
+    std::atomic<std::uint64_t> statusMisses_ = 0;
+    std::atomic<std::uint64_t> contentHits_ = 0;
+    std::atomic<std::uint64_t> contentMisses_ = 0;
+
+    Shard&
+    shard(std::string const& path) noexcept;
+};
+
+/** Return a file system which reads through a shared cache.
+
+    The returned file system has its own working
+    directory, so that each thread can resolve
+    relative paths independently, while the status
+    and contents of files are shared.
+*/
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>
+createCachingFileSystem(SharedFileSystemCache& cache);
+
+} // mrdocs
+} // clang
+
+#endif
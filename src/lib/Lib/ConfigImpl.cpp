@@ -86,9 +86,9 @@ shouldVisitSymbol(
         if (filePath.starts_with(p))
         {
             bool validPattern = std::ranges::any_of(
-                    settings_.input.filePatterns,
-                    [&](auto const &pattern) {
-                        return globMatch(pattern, filePath);
+                    settings_.filePatternFilter,
+                    [&](GlobPattern const& pattern) {
+                        return pattern.matches(filePath);
                     });
             if (validPattern)
             {
@@ -161,6 +161,10 @@ load(
     for(std::string_view pattern: s.implementationDefined)
         s.implementationDefinedFilter.emplace_back(pattern);
 
+    // Compile the input file patterns
+    for(std::string_view pattern: s.input.filePatterns)
+        s.filePatternFilter.emplace_back(pattern);
+
     s.symbolFilter.finalize(false, false, false);
 
     return c;
@@ -56,6 +56,10 @@ public:
         /** Namespaces for symbols rendered as "implementation-defined".
          */
         std::vector<FilterPattern> implementationDefinedFilter;
+
+        /** Compiled patterns of the input files to extract.
+         */
+        std::vector<GlobPattern> filePatternFilter;
     };
 
     /// @copydoc Config::settings()
@@ -12,13 +12,32 @@
 
 #include "CorpusImpl.hpp"
 #include "lib/AST/ASTVisitor.hpp"
+#include "lib/Lib/ExecutionContext.hpp"
 #include "lib/Metadata/Finalize.hpp"
+#include "lib/Metadata/Serialize.hpp"
+#include "lib/Lib/CachingFileSystem.hpp"
+#include "lib/Lib/ExtractionCache.hpp"
+#include "lib/Lib/ExtractionRegistry.hpp"
 #include "lib/Lib/Lookup.hpp"
+#include "lib/Lib/SharedPCH.hpp"
+#include "lib/Lib/TimingProfile.hpp"
+#include "lib/Lib/TranslationUnitBatch.hpp"
+#include "lib/Lib/WorkerPool.hpp"
 #include "lib/Support/Error.hpp"
+#include "lib/Support/Stats.hpp"
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/Path.hpp>
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <optional>
+#include <utility>
 
 namespace clang {
 namespace mrdocs {
@@ -28,22 +47,7 @@ CorpusImpl::
 begin() const noexcept ->
     iterator
 {
-    if(info_.empty())
-        return end();
-    // KRYSTIAN NOTE: this is far from ideal, but i'm not sure
-    // to what extent implementation detail should be hidden.
-    return iterator(this, info_.begin()->get(),
-        [](const Corpus* corpus, const Info* val) ->
-            const Info*
-        {
-            MRDOCS_ASSERT(val);
-            const CorpusImpl* impl =
-                static_cast<const CorpusImpl*>(corpus);
-            auto it = impl->info_.find(val->id);
-            if(++it == impl->info_.end())
-                return nullptr;
-            return it->get();
-        });
+    return iterator(index_.data());
 }
 
 auto
@@ -51,7 +55,7 @@ CorpusImpl::
 end() const noexcept ->
     iterator
 {
-    return iterator();
+    return iterator(index_.data() + index_.size());
 }
 
 Info*
@@ -76,6 +80,116 @@ find(
     return nullptr;
 }
 
+void
+CorpusImpl::
+buildIndex()
+{
+    // The qualified names are computed once,
+    // rather than for each comparison
+    std::vector<std::pair<std::string, Info const*>> entries;
+    entries.reserve(info_.size());
+    std::string temp;
+    for(auto const& I : info_)
+        entries.emplace_back(getFullyQualifiedName(*I, temp), I.get());
+    std::ranges::sort(entries,
+        [](auto const& lhs, auto const& rhs)
+        {
+            if(lhs.first != rhs.first)
+                return lhs.first < rhs.first;
+            return lhs.second->id < rhs.second->id;
+        });
+
+    index_.clear();
+    index_.reserve(entries.size());
+    for(auto const& entry : entries)
+        index_.push_back(entry.second);
+
+    byKind_.clear();
+    byName_.clear();
+    byFile_.clear();
+    for(Info const* I : index_)
+    {
+        byKind_[I->Kind].push_back(I);
+        if(! I->Name.empty())
+            byName_[I->Name].push_back(I);
+
+        // A symbol is added once for each file, even
+        // when it is declared more than once in it
+        auto addFile = [&](std::string_view file)
+        {
+            auto& infos = byFile_[file];
+            if(infos.empty() || infos.back() != I)
+                infos.push_back(I);
+        };
+        auto addLocation = [&](Location const& loc)
+        {
+            addFile(loc.path());
+            if(loc.filename() != loc.path())
+                addFile(loc.filename());
+        };
+        visit(*I, [&]<class T>(T const& U)
+        {
+            if constexpr(std::derived_from<T, SourceInfo>)
+            {
+                if(U.DefLoc)
+                    addLocation(*U.DefLoc);
+                for(Location const& loc : U.Loc)
+                    addLocation(loc);
+            }
+        });
+    }
+
+    auto const sortedKeys = [](auto const& map)
+    {
+        std::vector<std::string_view> keys;
+        keys.reserve(map.size());
+        for(auto const& entry : map)
+        {
+            if(! entry.first.empty())
+                keys.push_back(entry.first);
+        }
+        std::ranges::sort(keys);
+        return keys;
+    };
+    nameKeys_ = sortedKeys(byName_);
+    fileKeys_ = sortedKeys(byFile_);
+}
+
+namespace {
+template<class Map, class Key>
+std::span<Info const* const>
+findIn(
+    Map const& map,
+    Key const& key) noexcept
+{
+    auto it = map.find(key);
+    if(it == map.end())
+        return {};
+    return it->second;
+}
+} // (anon)
+
+std::span<Info const* const>
+CorpusImpl::
+findByKind(InfoKind kind) const noexcept
+{
+    return findIn(byKind_, kind);
+}
+
+std::span<Info const* const>
+CorpusImpl::
+findByName(std::string_view name) const noexcept
+{
+    return findIn(byName_, name);
+}
+
+std::span<Info const* const>
+CorpusImpl::
+findByFile(std::string_view file) const noexcept
+{
+    return findIn(byFile_, file);
+}
+
 //------------------------------------------------
 
 namespace {
@@ -96,6 +210,48 @@ format_duration(
         return fmt::format("{:.02f} s", delta_s);
     }
 }
+
+/** Parse a shard in the form "i/N", where i is 1-based.
+
+    @return The zero-based index and count of the shard.
+*/
+mrdocs::Expected<std::pair<std::size_t, std::size_t>>
+parseShard(std::string_view s)
+{
+    std::size_t index = 0;
+    std::size_t count = 0;
+    char const* const last = s.data() + s.size();
+    auto r = std::from_chars(s.data(), last, index);
+    if (r.ec == std::errc() && r.ptr != last && *r.ptr == '/')
+    {
+        r = std::from_chars(r.ptr + 1, last, count);
+    }
+    if (r.ec != std::errc() || r.ptr != last ||
+        index == 0 || count == 0 || index > count)
+    {
+        return Unexpected(formatError(
+            "Invalid shard \"{}\": expected \"i/N\" with 1 <= i <= N", s));
+    }
+    return std::make_pair(index - 1, count);
+}
+
+/** Keep the files of a shard.
+
+    The files are sorted so that every shard
+    selects from the same order.
+*/
+void
+selectShard(
+    std::vector<std::string>& files,
+    std::pair<std::size_t, std::size_t> shard)
+{
+    std::ranges::sort(files);
+    std::size_t i = 0;
+    std::erase_if(files, [&](std::string const&)
+    {
+        return i++ % shard.second != shard.first;
+    });
+}
 }
 
 mrdocs::Expected<std::unique_ptr<Corpus>>
@@ -123,35 +279,222 @@ build(
     // InfoSet in the execution context.
     InfoExecutionContext context(*config);
 
+    // Results are merged on dedicated reducer threads
+    // so that the workers can continue parsing. The
+    // queue holds at most two results per worker.
+    std::size_t const threadCount = config->threadPool().getThreadCount();
+    MergeQueueExecutionContext mergeQueue(
+        *config, context,
+        std::max<std::size_t>(threadCount / 8, 1),
+        2 * threadCount);
+
+    // Definitions extracted by one translation unit are
+    // skipped by the others. This is disabled with the
+    // extraction cache, since a cached translation unit
+    // would then depend on the results of other ones.
+    ExtractionRegistry registry;
+    ExtractionRegistry* sharedRegistry =
+        (*config)->cacheDir.empty() ? &registry : nullptr;
+
     // Create an `ASTActionFactory` to create multiple
     // `ASTAction`s that extract the AST for each translation unit.
     std::unique_ptr<tooling::FrontendActionFactory> action =
-        makeFrontendActionFactory(context, *config);
+        makeFrontendActionFactory(mergeQueue, *config, sharedRegistry);
     MRDOCS_ASSERT(action);
 
+    // ------------------------------------------
+    // Extraction cache
+    // ------------------------------------------
+    // When enabled, translation units whose compile
+    // command and files are unchanged since the last
+    // run are loaded from the cache instead of parsed.
+    std::unique_ptr<ExtractionCache> cache;
+    if (!(*config)->cacheDir.empty())
+    {
+        cache = std::make_unique<ExtractionCache>(
+            (*config)->cacheDir, *config);
+    }
+
+    // ------------------------------------------
+    // Timing profile
+    // ------------------------------------------
+    // The time taken by each translation unit is kept
+    // in the cache directory, and used to schedule the
+    // slowest ones first. Without a cache directory,
+    // the time is only estimated.
+    std::string profilePath;
+    if (!(*config)->cacheDir.empty())
+    {
+        profilePath = files::appendPath(
+            (*config)->cacheDir, "mrdocs-profile.txt");
+    }
+    TimingProfile profile = TimingProfile::load(profilePath);
+
+    // ------------------------------------------
+    // File system cache
+    // ------------------------------------------
+    // The status and contents of the headers shared
+    // by translation units are read from disk once.
+    SharedFileSystemCache fsCache;
+
+    // ------------------------------------------
+    // Shared precompiled headers
+    // ------------------------------------------
+    // When enabled, the includes common to a group of
+    // translation units are precompiled once, before
+    // the extraction starts.
+    SharedPCH sharedPCH(fsCache);
+
+    // Get a copy of the filename strings
+    std::vector<std::string> files = compilations.getAllFiles();
+    MRDOCS_CHECK(files, "Compilations database is empty");
+
+    // ------------------------------------------
+    // Shard
+    // ------------------------------------------
+    // A shard extracts every N-th file only. The
+    // partial corpus is merged with those of the
+    // other shards and finalized by a later run.
+    std::optional<std::pair<std::size_t, std::size_t>> shard;
+    if (!(*config)->shard.empty())
+    {
+        MRDOCS_TRY(shard, parseShard((*config)->shard));
+        corpus->partial_ = true;
+    }
+
+    // ------------------------------------------
+    // Batches
+    // ------------------------------------------
+    // Source files with identical compile commands
+    // are parsed together, so that the headers they
+    // share are parsed once per batch. Files are
+    // cached separately, so there are no batches
+    // with the extraction cache.
+    //
+    // In headers-only mode, the input headers are
+    // parsed instead, through umbrella batches which
+    // use the flags of the most common compile command.
+    std::vector<TranslationUnitBatch> batches;
+    if ((*config)->headersOnly)
+    {
+        std::vector<std::string> headers = findInputHeaders(*config);
+        MRDOCS_CHECK(headers, "No input headers found");
+        if (shard)
+        {
+            selectShard(headers, *shard);
+        }
+        batches = makeHeaderBatches(compilations, headers,
+            (*config)->batchTranslationUnits);
+        files.clear();
+    }
+    else
+    {
+        if (shard)
+        {
+            selectShard(files, *shard);
+        }
+        if (!cache)
+        {
+            batches = makeBatches(compilations, files,
+                (*config)->batchTranslationUnits);
+        }
+    }
+    BatchCompilationDatabase batchCompilations(compilations, batches);
+
     // ------------------------------------------
     // "Process file" task
     // ------------------------------------------
     auto const processFile =
-        [&](std::string path)
+        [&](std::string const& path,
+            ExecutionContext& sink,
+            tooling::FrontendActionFactory* fileAction)
         {
-            // Each thread gets an independent copy of a VFS to allow different
-            // concurrent working directories.
-            IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS =
-                llvm::vfs::createPhysicalFileSystem();
+            // Results go straight to the execution context unless
+            // the translation unit needs to be stored in the cache
+            ExecutionContext* fileSink = &sink;
+            std::optional<CachingExecutionContext> cachingContext;
+            std::unique_ptr<tooling::FrontendActionFactory> cachingAction;
+            if (cache)
+            {
+                std::string key = cache->key(
+                    batchCompilations.getCompileCommands(path));
+                if (auto entry = cache->load(key))
+                {
+                    sink.report(
+                        std::move(entry->info),
+                        std::move(entry->diags));
+                    return;
+                }
+                cachingContext.emplace(
+                    *config, sink, *cache, std::move(key));
+                cachingAction = makeFrontendActionFactory(
+                    *cachingContext, *config);
+                fileAction = cachingAction.get();
+                fileSink = &*cachingContext;
+            }
 
-            // KRYSTIAN NOTE: ClangTool applies the SyntaxOnly, StripOutput,
-            // and StripDependencyFile argument adjusters
-            tooling::ClangTool Tool(compilations, { path },
-                std::make_shared<PCHContainerOperations>(), FS);
+            auto const runTool = [&](
+                SharedPCH::Group const* pch,
+                tooling::FrontendActionFactory* runAction)
+            {
+                // Each thread gets an independent copy of a VFS to allow different
+                // concurrent working directories, over a shared cache of files.
+                IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS =
+                    createCachingFileSystem(fsCache);
 
-            // Suppress error messages from the tool
-            Tool.setPrintErrorMessage(false);
+                // KRYSTIAN NOTE: ClangTool applies the SyntaxOnly, StripOutput,
+                // and StripDependencyFile argument adjusters
+                tooling::ClangTool Tool(batchCompilations, { path },
+                    std::make_shared<PCHContainerOperations>(), FS);
 
-            if (Tool.run(action.get()))
+                // Load the precompiled header before the source file
+                if (pch)
+                {
+                    Tool.appendArgumentsAdjuster(
+                        tooling::getInsertArgumentAdjuster(
+                            SharedPCH::includeArgs(*pch),
+                            tooling::ArgumentInsertPosition::BEGIN));
+                }
+
+                // Suppress error messages from the tool
+                Tool.setPrintErrorMessage(false);
+
+                return Tool.run(runAction) == 0;
+            };
+
+            auto const parseStart = clock_type::now();
+            bool parsed = false;
+            if (SharedPCH::Group const* pch = sharedPCH.find(path))
+            {
+                // A header which cannot be included twice makes
+                // the file fail with the precompiled header, and
+                // it is then parsed again without it. The results
+                // are held until the parse succeeded, and are not
+                // published to the registry.
+                BufferedExecutionContext buffered(*config, *fileSink);
+                std::unique_ptr<tooling::FrontendActionFactory> pchAction =
+                    makeFrontendActionFactory(buffered, *config);
+                if (runTool(pch, pchAction.get()))
+                {
+                    buffered.commit();
+                    sharedPCH.addHit(*pch);
+                    parsed = true;
+                }
+                else
+                {
+                    sharedPCH.addFallback();
+                }
+            }
+            else
+            {
+                sharedPCH.addMiss();
+            }
+            if (!parsed && !runTool(nullptr, fileAction))
             {
                 formatError("Failed to run action on {}", path).Throw();
             }
+            profile.record(path, std::chrono::duration_cast<
+                std::chrono::milliseconds>(clock_type::now() - parseStart));
         };
 
     // ------------------------------------------
@@ -160,18 +503,163 @@ build(
     // Traverse the AST for all translation units.
     // This operation happens on a thread pool.
     report::print(reportLevel, "Extracting declarations");
-
-    // Get a copy of the filename strings
-    std::vector<std::string> files = compilations.getAllFiles();
-    MRDOCS_CHECK(files, "Compilations database is empty");
     std::vector<Error> errors;
 
+    std::atomic<std::size_t> batchesParsed = 0;
+    std::atomic<std::size_t> batchesFailed = 0;
+
+    // The results of a batch are held until it compiled,
+    // since its files are parsed separately otherwise.
+    // For the same reason, a batch does not publish its
+    // definitions to the registry.
+    auto const processBatch =
+        [&](TranslationUnitBatch const& batch, ExecutionContext& sink)
+        {
+            BufferedExecutionContext buffered(*config, sink);
+            std::unique_ptr<tooling::FrontendActionFactory> batchAction =
+                makeFrontendActionFactory(buffered, *config);
+
+            IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS =
+                createCachingFileSystem(fsCache);
+            tooling::ClangTool Tool(batchCompilations, { batch.path },
+                std::make_shared<PCHContainerOperations>(), FS);
+            Tool.mapVirtualFile(batch.path, batch.contents);
+            Tool.setPrintErrorMessage(false);
+            if (Tool.run(batchAction.get()))
+            {
+                return false;
+            }
+            buffered.commit();
+            return true;
+        };
+
+    if ((*config)->sharedPch && files.size() > 1)
+    {
+        Stats::Timer pchTimer;
+        sharedPCH.build(compilations, files, config->threadPool());
+        Stats::get().addPhase("pch-build", pchTimer.elapsed());
+    }
+
+    // ------------------------------------------
+    // Worker processes
+    // ------------------------------------------
+    // When enabled, the files and batches are parsed
+    // by worker processes which start with a copy of
+    // the current state, and their results are sent
+    // back to the merge queue. The workers are forked
+    // now, while the other threads are idle.
+    std::optional<WorkerPool> workers;
+    if ((*config)->workerProcesses != 0)
+    {
+        // The caches of a worker are its own, so their
+        // counters are recorded as statistics of each
+        // task, which the pool sends to the parent
+        auto const cacheCounters = [&]
+        {
+            return std::array<std::pair<std::string_view, std::uint64_t>, 10>{{
+                { "vfs-status-hits", fsCache.statusHits() },
+                { "vfs-status-misses", fsCache.statusMisses() },
+                { "vfs-read-hits", fsCache.contentHits() },
+                { "vfs-read-misses", fsCache.contentMisses() },
+                { "pch-hits", sharedPCH.hits() },
+                { "pch-misses", sharedPCH.misses() },
+                { "pch-fallbacks", sharedPCH.fallbacks() },
+                { "registry-skipped", registry.skipped() },
+                { "cache-hits", cache ? cache->hits() : 0 },
+                { "cache-misses", cache ? cache->misses() : 0 } }};
+        };
+        auto const runTask =
+            [&](std::string_view request, ExecutionContext& sink)
+            {
+                if (request.starts_with('b'))
+                {
+                    std::size_t i = 0;
+                    std::from_chars(
+                        request.data() + 1,
+                        request.data() + request.size(), i);
+                    if (i >= batches.size() || !processBatch(batches[i], sink))
+                    {
+                        formatError("Failed to run action on a batch").Throw();
+                    }
+                    return;
+                }
+                // Definitions are only skipped across the
+                // translation units of the same worker
+                std::unique_ptr<tooling::FrontendActionFactory> workerAction =
+                    makeFrontendActionFactory(sink, *config, sharedRegistry);
+                processFile(std::string(request.substr(1)),
+                    sink, workerAction.get());
+            };
+        workers.emplace(*config,
+            [&](std::string_view request, ExecutionContext& sink)
+            {
+                auto const before = cacheCounters();
+                auto const addCounters = [&]
+                {
+                    auto const after = cacheCounters();
+                    for (std::size_t i = 0; i < after.size(); ++i)
+                    {
+                        Stats::get().addCounter(after[i].first,
+                            after[i].second - before[i].second);
+                    }
+                };
+                try
+                {
+                    runTask(request, sink);
+                }
+                catch (...)
+                {
+                    addCounters();
+                    throw;
+                }
+                addCounters();
+            },
+            (*config)->workerProcesses,
+            (*config)->workerMaxTranslationUnits,
+            (*config)->workerMaxMemory);
+        if (auto exp = workers->start(); !exp)
+        {
+            report::warn("Using threads instead of worker processes: {}",
+                exp.error());
+            workers.reset();
+        }
+    }
+
+    auto const extractFile = [&](std::string const& path)
+    {
+        if (!workers)
+        {
+            processFile(path, mergeQueue, action.get());
+            return;
+        }
+        auto const start = clock_type::now();
+        if (auto exp = workers->run("f" + path, mergeQueue); !exp)
+        {
+            exp.error().Throw();
+        }
+        profile.record(path, std::chrono::duration_cast<
+            std::chrono::milliseconds>(clock_type::now() - start));
+    };
+
+    auto const extractBatch = [&](std::size_t i)
+    {
+        if (!workers)
+        {
+            return processBatch(batches[i], mergeQueue);
+        }
+        return workers->run(fmt::format("b{}", i), mergeQueue).has_value();
+    };
+
+    auto const extractStart = clock_type::now();
+    std::atomic<clock_type::rep> busyTime = 0;
+    std::size_t threadCountUsed = 1;
+
     // Run the action on all files in the database
-    if (files.size() == 1)
+    if (files.size() == 1 && batches.empty())
     {
         try
         {
-            processFile(std::move(files.front()));
+            extractFile(files.front());
         }
         catch (Exception const& ex)
         {
@@ -181,21 +669,84 @@ build(
     else
     {
         TaskGroup taskGroup(config->threadPool());
-        std::size_t index = 0;
-        for (std::string& file : files)
+        threadCountUsed = threadCount;
+        std::atomic<std::size_t> index = 0;
+        std::atomic<std::size_t> total = batches.size() + files.size();
+        auto const postFile = [&](std::string path)
         {
             taskGroup.async(
-            [&, idx = ++index, path = std::move(file)]()
+            [&, path = std::move(path)]()
             {
                 report::log(reportLevel,
-                    "[{}/{}] \"{}\"", idx, files.size(), path);
-                processFile(path);
+                    "[{}/{}] \"{}\"", ++index, total.load(), path);
+                auto const taskStart = clock_type::now();
+                extractFile(path);
+                busyTime += (clock_type::now() - taskStart).count();
             });
+        };
+
+        // Batches go first, since they are the largest
+        for (std::size_t i = 0; i < batches.size(); ++i)
+        {
+            taskGroup.async(
+            [&, i]()
+            {
+                TranslationUnitBatch const& batch = batches[i];
+                report::log(reportLevel,
+                    "[{}/{}] batch of {} files", ++index, total.load(),
+                    batch.files.size());
+                auto const taskStart = clock_type::now();
+                bool const ok = extractBatch(i);
+                busyTime += (clock_type::now() - taskStart).count();
+                if (ok)
+                {
+                    ++batchesParsed;
+                    return;
+                }
+                ++batchesFailed;
+                total += batch.files.size();
+                for (std::string const& path : batch.files)
+                {
+                    postFile(path);
+                }
+            });
+        }
+
+        // Start the most expensive translation units first
+        for (std::size_t i : profile.schedule(files))
+        {
+            postFile(std::move(files[i]));
         }
         errors = taskGroup.wait();
     }
-    // Print diagnostics totals
-    context.reportEnd(reportLevel);
+
+    // Efficiency is the fraction of the time the
+    // workers were busy while extraction ran
+    auto const extractTime = clock_type::now() - extractStart;
+    Stats::get().addPhase("extract", extractTime);
+    if (threadCountUsed > 1 && extractTime.count() > 0)
+    {
+        double const efficiency =
+            static_cast<double>(busyTime.load()) /
+            (static_cast<double>(extractTime.count()) *
+                static_cast<double>(threadCountUsed));
+        report::log(reportLevel,
+            "Parallel efficiency: {:.1f}% ({} of work on {} threads in {})",
+            100.0 * efficiency,
+            format_duration(clock_type::duration(busyTime.load())),
+            threadCountUsed,
+            format_duration(extractTime));
+    }
+
+    if (!profilePath.empty())
+    {
+        if (auto exp = profile.store(profilePath); !exp)
+        {
+            report::warn("Failed to write timing profile: {}", exp.error());
+        }
+    }
+    // Wait for the merge and print diagnostics totals
+    mergeQueue.reportEnd(reportLevel);
 
     // ------------------------------------------
     // Report warning and error totals
@@ -211,10 +762,81 @@ build(
             "Warning: mapping failed because ", err);
     }
 
-    auto results = context.results();
+    report::log(reportLevel,
+        "Shard lock wait time: {}",
+        format_duration(context.lockWaitTime()));
+    Stats::get().addPhase("shard-lock-wait", context.lockWaitTime());
+
+    if (cache && !workers)
+    {
+        report::log(reportLevel,
+            "Extraction cache: {} hits, {} misses",
+            cache->hits(), cache->misses());
+        Stats::get().addCounter("cache-hits", cache->hits());
+        Stats::get().addCounter("cache-misses", cache->misses());
+    }
+
+    // The caches and counters used while parsing
+    // belong to the workers when there are any
+    if (workers)
+    {
+        report::log(reportLevel,
+            "Worker processes: {} replaced, {} terminated",
+            workers->recycled(), workers->crashes());
+        Stats::get().addCounter("worker-recycled", workers->recycled());
+        Stats::get().addCounter("worker-crashes", workers->crashes());
+    }
+    else
+    {
+        report::log(reportLevel,
+            "File system cache: {} of {} status lookups and {} of {} reads cached",
+            fsCache.statusHits(), fsCache.statusHits() + fsCache.statusMisses(),
+            fsCache.contentHits(), fsCache.contentHits() + fsCache.contentMisses());
+        Stats::get().addCounter("vfs-status-hits", fsCache.statusHits());
+        Stats::get().addCounter("vfs-status-misses", fsCache.statusMisses());
+        Stats::get().addCounter("vfs-read-hits", fsCache.contentHits());
+        Stats::get().addCounter("vfs-read-misses", fsCache.contentMisses());
+    }
+
+    if (!batches.empty())
+    {
+        report::log(reportLevel,
+            "Batches: {} of {} compiled, {} parsed one file at a time",
+            batchesParsed.load(), batches.size(), batchesFailed.load());
+        Stats::get().addCounter("batches-parsed", batchesParsed);
+        Stats::get().addCounter("batches-failed", batchesFailed);
+    }
+
+    if ((*config)->sharedPch && !workers)
+    {
+        std::uint64_t const parsed =
+            sharedPCH.hits() + sharedPCH.fallbacks() + sharedPCH.misses();
+        report::log(reportLevel,
+            "Shared PCH: {} of {} translation units used one of {} headers "
+            "built in {}, {} fell back, estimated {} saved",
+            sharedPCH.hits(), parsed, sharedPCH.builtCount(),
+            format_duration(sharedPCH.buildTime()),
+            sharedPCH.fallbacks(),
+            format_duration(sharedPCH.savedTime()));
+        Stats::get().addCounter("pch-hits", sharedPCH.hits());
+        Stats::get().addCounter("pch-misses", sharedPCH.misses());
+        Stats::get().addCounter("pch-fallbacks", sharedPCH.fallbacks());
+        Stats::get().addPhase("pch-saved-estimate", sharedPCH.savedTime());
+    }
+
+    if (sharedRegistry && !workers)
+    {
+        report::log(reportLevel,
+            "Skipped {} definitions extracted by other translation units",
+            registry.skipped());
+        Stats::get().addCounter("registry-skipped", registry.skipped());
+    }
+
+    auto results = mergeQueue.results();
     if(! results)
         return Unexpected(results.error());
     corpus->info_ = std::move(results.value());
+    corpus->buildIndex();
 
     report::log(reportLevel,
         "Extracted {} declarations in {}",
@@ -224,11 +846,239 @@ build(
     // ------------------------------------------
     // Finalize corpus
     // ------------------------------------------
+    // The symbols of a shard are finalized
+    // after merging all the shards
+    if (corpus->partial_)
+    {
+        return corpus;
+    }
+
+    Stats::Timer lookupTimer;
     auto lookup = std::make_unique<SymbolLookup>(*corpus);
-    finalize(corpus->info_, *lookup);
+    Stats::get().addPhase("lookup", lookupTimer.elapsed());
+
+    Stats::Timer finalizeTimer;
+    MRDOCS_TRY(finalize(corpus->info_, *lookup, config->threadPool()));
+    Stats::get().addPhase("finalize", finalizeTimer.elapsed());
+
+    return corpus;
+}
+
+//------------------------------------------------
+
+namespace {
+constexpr std::string_view corpusMagic = "MRDC";
+constexpr std::string_view partialCorpusMagic = "MRDP";
+
+/** A memory mapped corpus file split into one record per symbol.
+*/
+struct CorpusFile
+{
+    std::unique_ptr<llvm::MemoryBuffer> buffer;
+    std::vector<std::string_view> records;
+    bool partial = false;
+};
+
+mrdocs::Expected<CorpusFile>
+openCorpusFile(std::string_view path)
+{
+    // The file is memory mapped and the symbols
+    // are decoded directly from the mapped bytes
+    auto buffer = llvm::MemoryBuffer::getFile(
+        path, false, false);
+    if (!buffer)
+    {
+        return Unexpected(formatError(
+            "Failed to open corpus file \"{}\": {}",
+            path, buffer.getError().message()));
+    }
+
+    CorpusFile file;
+    file.buffer = std::move(*buffer);
+    file.partial = file.buffer->getBuffer().starts_with(partialCorpusMagic);
+    try
+    {
+        BinaryReader r(file.buffer->getBuffer());
+        r.readHeader(file.partial ? partialCorpusMagic : corpusMagic);
+        auto n = r.readInteger();
+        file.records.reserve(std::min<std::uint64_t>(
+            n, r.remaining().size()));
+        while (n--)
+        {
+            file.records.push_back(r.readBytes(r.readInteger()));
+        }
+    }
+    catch (Exception const& ex)
+    {
+        return Unexpected(formatError(
+            "Invalid corpus file \"{}\": {}", path, ex.error()));
+    }
+    return file;
+}
+
+/** Decode the records of a corpus file concurrently.
+
+    Each task decodes a chunk of records and
+    passes the index of its first record and
+    its symbols to `fn`, which may be called
+    concurrently.
+*/
+template <class Fn>
+mrdocs::Expected<void>
+decodeCorpusFile(
+    CorpusFile const& file,
+    std::string_view path,
+    ThreadPool& threadPool,
+    Fn&& fn)
+{
+    constexpr std::size_t recordsPerTask = 512;
+    TaskGroup taskGroup(threadPool);
+    for (std::size_t i = 0; i < file.records.size(); i += recordsPerTask)
+    {
+        taskGroup.async(
+        [&, first = i]()
+        {
+            std::size_t const last = std::min(
+                first + recordsPerTask, file.records.size());
+            std::vector<std::unique_ptr<Info>> chunk;
+            chunk.reserve(last - first);
+            for (std::size_t j = first; j < last; ++j)
+            {
+                chunk.push_back(BinaryReader(file.records[j]).readInfo());
+            }
+            fn(first, std::move(chunk));
+        });
+    }
+    if (auto errors = taskGroup.wait(); !errors.empty())
+    {
+        return Unexpected(formatError(
+            "Invalid corpus file \"{}\": {}", path, Error(errors)));
+    }
+    return {};
+}
+} // (anon)
+
+mrdocs::Expected<std::unique_ptr<Corpus>>
+CorpusImpl::
+load(
+    report::Level reportLevel,
+    std::shared_ptr<ConfigImpl const> const& config,
+    std::span<std::string const> paths)
+{
+    using clock_type = std::chrono::steady_clock;
+    auto start_time = clock_type::now();
+
+    MRDOCS_CHECK(paths, "No corpus files");
+    report::print(reportLevel, "Loading corpus");
+
+    std::unique_ptr<CorpusImpl> corpus = std::make_unique<CorpusImpl>(config);
+
+    // Partial corpora are merged one file at a time,
+    // so that only the merged symbols and a single
+    // mapped file are held in memory
+    InfoExecutionContext context(*config);
+    std::size_t partials = 0;
+    for (std::string const& path : paths)
+    {
+        MRDOCS_TRY(CorpusFile file, openCorpusFile(path));
+        if (!file.partial)
+        {
+            if (paths.size() != 1)
+            {
+                return Unexpected(formatError(
+                    "Corpus file \"{}\" is not a partial corpus "
+                    "and cannot be merged", path));
+            }
+
+            // Decode the records concurrently
+            std::vector<std::unique_ptr<Info>> infos(file.records.size());
+            MRDOCS_TRY(decodeCorpusFile(file, path, config->threadPool(),
+                [&](std::size_t first, std::vector<std::unique_ptr<Info>> chunk)
+                {
+                    std::ranges::move(chunk, infos.begin() + first);
+                }));
+            corpus->info_.reserve(infos.size());
+            for (auto& I : infos)
+            {
+                corpus->info_.emplace(std::move(I));
+            }
+            break;
+        }
+
+        // Each chunk of symbols is merged into the
+        // sharded context as soon as it is decoded
+        MRDOCS_TRY(decodeCorpusFile(file, path, config->threadPool(),
+            [&](std::size_t, std::vector<std::unique_ptr<Info>> chunk)
+            {
+                InfoSet info;
+                info.reserve(chunk.size());
+                for (auto& I : chunk)
+                {
+                    info.emplace(std::move(I));
+                }
+                context.report(std::move(info), Diagnostics());
+            }));
+        ++partials;
+    }
+
+    if (partials != 0)
+    {
+        auto results = context.results();
+        if (!results)
+        {
+            return Unexpected(results.error());
+        }
+        corpus->info_ = std::move(results.value());
+        report::log(reportLevel,
+            "Merged {} declarations from {} partial corpora",
+            corpus->info_.size(), partials);
+    }
+    corpus->buildIndex();
+
+    auto const loadTime = clock_type::now() - start_time;
+    Stats::get().addPhase("load", loadTime);
+    report::log(reportLevel,
+        "Loaded {} declarations in {}",
+        corpus->info_.size(),
+        format_duration(loadTime));
+
+    if (partials != 0)
+    {
+        // The symbols of partial corpora
+        // are finalized once merged
+        Stats::Timer lookupTimer;
+        auto lookup = std::make_unique<SymbolLookup>(*corpus);
+        Stats::get().addPhase("lookup", lookupTimer.elapsed());
+
+        Stats::Timer finalizeTimer;
+        MRDOCS_TRY(finalize(corpus->info_, *lookup, config->threadPool()));
+        Stats::get().addPhase("finalize", finalizeTimer.elapsed());
+    }
 
     return corpus;
 }
 
+mrdocs::Expected<void>
+CorpusImpl::
+save(std::string_view path) const
+{
+    std::string data;
+    BinaryWriter w(data);
+    w.writeHeader(partial_ ? partialCorpusMagic : corpusMagic);
+    w.writeInfoSet(info_);
+
+    if (auto err = llvm::writeToOutput(path,
+        [&](llvm::raw_ostream& os)
+        {
+            os << data;
+            return llvm::Error::success();
+        }))
+    {
+        return Unexpected(toError(std::move(err)));
+    }
+    Stats::get().addBytesWritten(data.size());
+    return {};
+}
+
 } // mrdocs
 } // clang
@@ -20,7 +20,11 @@
 #include <mrdocs/Support/Error.hpp>
 #include <clang/Tooling/CompilationDatabase.h>
 #include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -92,6 +96,75 @@ public:
         std::shared_ptr<ConfigImpl const> const& config,
         tooling::CompilationDatabase const& compilations);
 
+    /** Load a corpus from files.
+
+        The files must have been written by @ref save.
+        The symbols are decoded concurrently on the
+        thread pool of the configuration.
+
+        Either a single complete corpus, or any number
+        of partial corpora can be loaded. Partial
+        corpora are merged one file at a time, so
+        that only the merged symbols are held in
+        memory, and the result is then finalized.
+
+        @param reportLevel Error reporting level.
+        @param config A shared pointer to the configuration.
+        @param paths The paths of the corpus files.
+    */
+    [[nodiscard]]
+    static
+    mrdocs::Expected<std::unique_ptr<Corpus>>
+    load(
+        report::Level reportLevel,
+        std::shared_ptr<ConfigImpl const> const& config,
+        std::span<std::string const> paths);
+
+    /** Write the corpus to a file.
+
+        The symbols are written in a compact,
+        versioned binary format which can be read
+        back with @ref load. A corpus extracted
+        for a shard is written as a partial corpus.
+
+        @param path The path of the corpus file.
+    */
+    mrdocs::Expected<void>
+    save(std::string_view path) const;
+
+    /** Return true if the corpus was extracted for a shard.
+
+        The symbols of a partial corpus are not
+        finalized, and only some of the source
+        files contributed to them.
+    */
+    bool
+    isPartial() const noexcept
+    {
+        return partial_;
+    }
+
+    std::span<Info const* const>
+    findByKind(InfoKind kind) const noexcept override;
+
+    std::span<Info const* const>
+    findByName(std::string_view name) const noexcept override;
+
+    std::span<Info const* const>
+    findByFile(std::string_view file) const noexcept override;
+
+    std::span<std::string_view const>
+    indexedNames() const noexcept override
+    {
+        return nameKeys_;
+    }
+
+    std::span<std::string_view const>
+    indexedFiles() const noexcept override
+    {
+        return fileKeys_;
+    }
+
 private:
     Info const*
     find(
@@ -106,6 +179,14 @@ private:
     get(
         SymbolID const& id) noexcept;
 
+    /** Build the index of all symbols, and the secondary indexes.
+
+        This must be called once the set of
+        symbols is complete.
+    */
+    void
+    buildIndex();
+
 private:
     friend class Corpus;
 
@@ -113,6 +194,23 @@ private:
 
     // Info keyed on Symbol ID.
     InfoSet info_;
+
+    // The symbols ordered by qualified name
+    std::vector<Info const*> index_;
+
+    // The secondary indexes, in the order of index_.
+    // The names are views of the names of the symbols,
+    // and the files are views of the FileTable paths.
+    std::unordered_map<InfoKind, std::vector<Info const*>> byKind_;
+    std::unordered_map<std::string_view, std::vector<Info const*>> byName_;
+    std::unordered_map<std::string_view, std::vector<Info const*>> byFile_;
+
+    // The sorted keys of byName_ and byFile_
+    std::vector<std::string_view> nameKeys_;
+    std::vector<std::string_view> fileKeys_;
+
+    // Whether the corpus was extracted for a shard
+    bool partial_ = false;
 };
 
 template<class T>
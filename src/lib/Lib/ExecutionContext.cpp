@@ -14,7 +14,9 @@
 #include "ExecutionContext.hpp"
 #include "lib/Metadata/Reduce.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <algorithm>
 #include <ranges>
+#include <utility>
 
 namespace clang {
 namespace mrdocs {
@@ -76,27 +78,49 @@ report(
     Diagnostics&& diags)
 {
     InfoSet info = std::move(results);
-    // KRYSTIAN TODO: read stage will be required to
-    // update Info references once we switch to using Info*
-    #if 0
+
+    // Partition the new Info by shard
+    std::array<std::vector<std::unique_ptr<Info>>, shardCount> parts;
+    while (!info.empty())
     {
-        std::shared_lock<std::shared_mutex> read_lock(mutex_);
+        auto node = info.extract(info.begin());
+        std::unique_ptr<Info>& I = node.value();
+        parts[shardIndex(I->id)].push_back(std::move(I));
     }
-    #endif
-
-    std::unique_lock<std::shared_mutex> write_lock(mutex_);
-    // Add all new Info to the existing set.
-    info_.merge(info);
 
-    // Merge duplicate IDs in info_.
-    for (auto& other : info)
+    for (std::size_t i = 0; i < shardCount; ++i)
     {
-        auto it = info_.find(other->id);
-        MRDOCS_ASSERT(it != info_.end());
-        merge(**it, std::move(*other));
+        if (parts[i].empty())
+        {
+            continue;
+        }
+        Shard& shard = shards_[i];
+        std::unique_lock<std::mutex> lock(shard.mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            auto const start = std::chrono::steady_clock::now();
+            lock.lock();
+            lockWait_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+
+        // Add all new Info to the shard, and merge duplicate IDs
+        for (std::unique_ptr<Info>& I : parts[i])
+        {
+            auto it = shard.info.find(I->id);
+            if (it == shard.info.end())
+            {
+                shard.info.emplace(std::move(I));
+            }
+            else
+            {
+                merge(**it, std::move(*I));
+            }
+        }
     }
 
     // Merge diagnostics and report any new messages.
+    std::lock_guard<std::mutex> lock(diagsMutex_);
     diags_.mergeAndReport(std::move(diags));
 }
 
@@ -111,7 +135,184 @@ mrdocs::Expected<InfoSet>
 InfoExecutionContext::
 results()
 {
-    return std::move(info_);
+    // The shards are disjoint, so the Info
+    // can be moved without merging
+    std::size_t size = 0;
+    for (Shard& shard : shards_)
+    {
+        size += shard.info.size();
+    }
+    InfoSet info;
+    info.reserve(size);
+    for (Shard& shard : shards_)
+    {
+        info.merge(shard.info);
+        MRDOCS_ASSERT(shard.info.empty());
+    }
+    return info;
+}
+
+// ----------------------------------------------------------------
+// MergeQueueExecutionContext
+// ----------------------------------------------------------------
+
+MergeQueueExecutionContext::
+MergeQueueExecutionContext(
+    ConfigImpl const& config,
+    ExecutionContext& next,
+    std::size_t reducers,
+    std::size_t capacity)
+    : ExecutionContext(config)
+    , next_(next)
+    , capacity_(std::max<std::size_t>(capacity, 1))
+{
+    reducers = std::max<std::size_t>(reducers, 1);
+    reducers_.reserve(reducers);
+    for (std::size_t i = 0; i < reducers; ++i)
+    {
+        reducers_.emplace_back([this] { runReducer(); });
+    }
+}
+
+MergeQueueExecutionContext::
+~MergeQueueExecutionContext()
+{
+    close();
+}
+
+void
+MergeQueueExecutionContext::
+runReducer()
+{
+    for (;;)
+    {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notEmpty_.wait(lock, [&] { return closed_ || !queue_.empty(); });
+            if (queue_.empty())
+            {
+                return;
+            }
+            item = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        notFull_.notify_one();
+
+        try
+        {
+            next_.report(std::move(item.info), std::move(item.diags));
+        }
+        catch (Exception const& ex)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            errors_.push_back(ex.error());
+        }
+        catch (std::exception const& ex)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            errors_.emplace_back(ex);
+        }
+    }
+}
+
+void
+MergeQueueExecutionContext::
+close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    notEmpty_.notify_all();
+    for (std::thread& reducer : reducers_)
+    {
+        if (reducer.joinable())
+        {
+            reducer.join();
+        }
+    }
+}
+
+void
+MergeQueueExecutionContext::
+report(
+    InfoSet&& info,
+    Diagnostics&& diags)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [&] { return queue_.size() < capacity_; });
+        MRDOCS_ASSERT(!closed_);
+        queue_.push_back({ std::move(info), std::move(diags) });
+    }
+    notEmpty_.notify_one();
+}
+
+void
+MergeQueueExecutionContext::
+reportEnd(report::Level level)
+{
+    close();
+    next_.reportEnd(level);
+}
+
+mrdocs::Expected<InfoSet>
+MergeQueueExecutionContext::
+results()
+{
+    close();
+    if (!errors_.empty())
+    {
+        return Unexpected(Error(errors_));
+    }
+    return next_.results();
+}
+
+//------------------------------------------------
+
+void
+BufferedExecutionContext::
+report(
+    InfoSet&& info,
+    Diagnostics&& diags)
+{
+    results_.push_back({
+        std::exchange(files_, {}), std::move(info), std::move(diags) });
+}
+
+void
+BufferedExecutionContext::
+reportFiles(
+    std::vector<std::string> const& files)
+{
+    files_ = files;
+}
+
+void
+BufferedExecutionContext::
+reportEnd(report::Level level)
+{
+    next_.reportEnd(level);
+}
+
+mrdocs::Expected<InfoSet>
+BufferedExecutionContext::
+results()
+{
+    return next_.results();
+}
+
+void
+BufferedExecutionContext::
+commit()
+{
+    for (auto& [files, info, diags] : results_)
+    {
+        next_.reportFiles(files);
+        next_.report(std::move(info), std::move(diags));
+    }
+    results_.clear();
 }
 
 } // mrdocs
@@ -18,8 +18,14 @@
 #include "Info.hpp"
 #include <mrdocs/Support/Error.hpp>
 #include <llvm/ADT/SmallString.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
-#include <shared_mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -83,6 +89,23 @@ public:
         InfoSet&& info,
         Diagnostics&& diags) = 0;
 
+    /** Adds the files a translation unit depends on.
+
+        This function is called before `report`
+        with the full path of the main file of the
+        translation unit and of every file it includes.
+
+        The default implementation does nothing.
+
+        @param files The full paths of the files.
+    */
+    virtual
+    void
+    reportFiles(
+        std::vector<std::string> const& files)
+    {
+    }
+
     /** Called when the execution is complete.
 
         Report the number of errors and warnings
@@ -113,13 +136,36 @@ public:
     It stores the `InfoSet` and `Diagnostics`
     objects, and returns them when `results`
     is called.
+
+    The symbols are partitioned by `SymbolID`
+    into independently locked shards, so that
+    translation units reporting different
+    symbols can be merged concurrently.
  */
 class InfoExecutionContext
     : public ExecutionContext
 {
-    std::shared_mutex mutex_;
+    static constexpr std::size_t shardCount = 64;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        InfoSet info;
+    };
+
+    std::array<Shard, shardCount> shards_;
+    std::mutex diagsMutex_;
     Diagnostics diags_;
-    InfoSet info_;
+    std::atomic<std::chrono::nanoseconds::rep> lockWait_ = 0;
+
+    static
+    std::size_t
+    shardIndex(SymbolID const& id) noexcept
+    {
+        // SymbolIDs are hashes, so any byte
+        // is uniformly distributed
+        return id.data()[19] % shardCount;
+    }
 
 public:
     using ExecutionContext::ExecutionContext;
@@ -146,6 +192,174 @@ public:
     */
     mrdocs::Expected<InfoSet>
     results() override;
+
+    /** Return the total time spent waiting for shard locks.
+
+        This is the sum over all threads of the
+        time spent blocked in `report` while
+        another thread was merging into the
+        same shard. When results are queued,
+        these are the reducer threads.
+    */
+    std::chrono::nanoseconds
+    lockWaitTime() const noexcept
+    {
+        return std::chrono::nanoseconds(lockWait_.load());
+    }
+};
+
+// ----------------------------------------------------------------
+
+/** An execution context which merges results on dedicated threads.
+
+    Calls to `report` place the results of a
+    translation unit in a bounded queue and
+    return immediately, so the calling thread
+    can begin parsing the next translation unit.
+
+    A fixed number of reducer threads remove
+    results from the queue and forward them to
+    another execution context, which performs
+    the merge.
+
+    When the queue is full, `report` blocks until
+    a reducer removes an entry. This bounds the
+    number of unmerged results held in memory
+    when the reducers fall behind.
+*/
+class MergeQueueExecutionContext
+    : public ExecutionContext
+{
+    struct Item
+    {
+        InfoSet info;
+        Diagnostics diags;
+    };
+
+    ExecutionContext& next_;
+    std::size_t const capacity_;
+
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<Item> queue_;
+    bool closed_ = false;
+    std::vector<Error> errors_;
+
+    std::vector<std::thread> reducers_;
+
+    void
+    runReducer();
+
+    void
+    close();
+
+public:
+    /** Constructor.
+
+        @param config The configuration to use.
+        @param next The execution context the results are merged into.
+        @param reducers The number of reducer threads.
+        @param capacity The maximum number of queued results.
+    */
+    MergeQueueExecutionContext(
+        ConfigImpl const& config,
+        ExecutionContext& next,
+        std::size_t reducers,
+        std::size_t capacity);
+
+    /** Destructor.
+
+        Any queued results are merged before
+        the reducer threads are joined.
+    */
+    ~MergeQueueExecutionContext();
+
+    /// @copydoc ExecutionContext::report
+    void
+    report(
+        InfoSet&& info,
+        Diagnostics&& diags) override;
+
+    /** Called when the execution is complete.
+
+        Waits for all queued results to be
+        merged and forwards the call to the
+        next execution context.
+
+        @param level The report level.
+    */
+    void
+    reportEnd(report::Level level) override;
+
+    /** Returns the results of the execution.
+
+        Waits for all queued results to be merged
+        and returns the results of the next
+        execution context.
+
+        @return The results of the execution, or
+        the errors thrown while merging.
+    */
+    mrdocs::Expected<InfoSet>
+    results() override;
+};
+
+//------------------------------------------------
+
+/** An execution context which holds results until committed.
+
+    The results of a batch, or of a file parsed
+    with a precompiled header, are only reported
+    when the parse succeeded, since the files are
+    parsed again otherwise.
+*/
+class BufferedExecutionContext
+    : public ExecutionContext
+{
+    struct Result
+    {
+        std::vector<std::string> files;
+        InfoSet info;
+        Diagnostics diags;
+    };
+
+    ExecutionContext& next_;
+    std::vector<std::string> files_;
+    std::vector<Result> results_;
+
+public:
+    BufferedExecutionContext(
+        ConfigImpl const& config,
+        ExecutionContext& next) noexcept
+        : ExecutionContext(config)
+        , next_(next)
+    {
+    }
+
+    /// @copydoc ExecutionContext::report
+    void
+    report(
+        InfoSet&& info,
+        Diagnostics&& diags) override;
+
+    /// @copydoc ExecutionContext::reportFiles
+    void
+    reportFiles(
+        std::vector<std::string> const& files) override;
+
+    /// @copydoc ExecutionContext::reportEnd
+    void
+    reportEnd(report::Level level) override;
+
+    /// @copydoc ExecutionContext::results
+    mrdocs::Expected<InfoSet>
+    results() override;
+
+    /** Report the held results to the next context.
+    */
+    void
+    commit();
 };
 
 } // mrdocs
@@ -0,0 +1,320 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "ExtractionCache.hpp"
+#include "lib/Metadata/Serialize.hpp"
+#include "lib/Support/Error.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Version.hpp>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
+#include <algorithm>
+#include <ranges>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+constexpr std::string_view entryMagic = "MRDT";
+
+/** Append a length-prefixed string to a key.
+
+    The prefix ensures that the concatenation of
+    different sequences of strings is unique.
+*/
+void
+appendKey(std::string& key, std::string_view s)
+{
+    key += std::to_string(s.size());
+    key += ':';
+    key += s;
+}
+
+/** Return true if an option does not affect extraction.
+*/
+bool
+isIgnoredSetting(std::string_view name)
+{
+    static constexpr std::string_view ignored[] = {
+        "inputs",
+        "config",
+        "output",
+        "compilation-database",
+        "cmake",
+        "generate",
+        "multipage",
+        "base-url",
+        "addons",
+        "concurrency",
+        "worker-processes",
+        "worker-max-translation-units",
+        "worker-max-memory",
+        "verbose",
+        "report",
+        "ignore-map-errors",
+        "ignore-failures",
+        "cache-dir",
+        "corpus-out",
+        "corpus-in",
+        "stats",
+        "batch-translation-units",
+        "shard",
+    };
+    return std::ranges::find(ignored, name) != std::end(ignored);
+}
+
+} // (anon)
+
+ExtractionCache::
+ExtractionCache(
+    std::string_view dir,
+    ConfigImpl const& config)
+    : dir_(dir)
+{
+    if (auto err = files::createDirectory(dir_))
+    {
+        report::warn("Failed to create cache directory: {}", err);
+    }
+
+    appendKey(settingsKey_, project_version);
+    appendKey(settingsKey_, std::to_string(binaryFormatVersion));
+    Config::Settings settings = config.settings();
+    settings.visit([&]<class T>(std::string_view name, T const& value)
+    {
+        if (isIgnoredSetting(name))
+        {
+            return;
+        }
+        appendKey(settingsKey_, name);
+        if constexpr (std::same_as<T, std::string>)
+        {
+            appendKey(settingsKey_, value);
+        }
+        else if constexpr (std::ranges::range<T>)
+        {
+            appendKey(settingsKey_, std::to_string(std::ranges::size(value)));
+            for (std::string const& elem : value)
+            {
+                appendKey(settingsKey_, elem);
+            }
+        }
+        else
+        {
+            appendKey(settingsKey_, std::to_string(
+                static_cast<std::int64_t>(value)));
+        }
+    });
+}
+
+std::string
+ExtractionCache::
+key(std::vector<tooling::CompileCommand> const& cmds) const
+{
+    std::string key = settingsKey_;
+    for (tooling::CompileCommand const& cmd : cmds)
+    {
+        appendKey(key, cmd.Directory);
+        appendKey(key, cmd.Filename);
+        for (std::size_t i = 0; i < cmd.CommandLine.size(); ++i)
+        {
+            // The output file does not affect the AST
+            std::string_view arg = cmd.CommandLine[i];
+            if (arg == "-o")
+            {
+                ++i;
+                continue;
+            }
+            if (arg.starts_with("-o"))
+            {
+                continue;
+            }
+            appendKey(key, arg);
+        }
+    }
+    return llvm::utohexstr(llvm::xxh3_64bits(key), true, 16);
+}
+
+std::string
+ExtractionCache::
+entryPath(std::string_view key) const
+{
+    return files::appendPath(dir_, fmt::format("{}.tu", key));
+}
+
+std::optional<std::uint64_t>
+ExtractionCache::
+contentHash(std::string const& path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = contentHashes_.find(path);
+        if (it != contentHashes_.end())
+        {
+            return it->second;
+        }
+    }
+    auto buffer = llvm::MemoryBuffer::getFile(
+        path, false, false);
+    if (!buffer)
+    {
+        return std::nullopt;
+    }
+    std::uint64_t const hash = llvm::xxh3_64bits(
+        (*buffer)->getBuffer());
+    std::lock_guard<std::mutex> lock(mutex_);
+    contentHashes_.emplace(path, hash);
+    return hash;
+}
+
+std::optional<ExtractionCache::Entry>
+ExtractionCache::
+load(std::string_view key)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(
+        entryPath(key), false, false);
+    if (!buffer)
+    {
+        ++misses_;
+        return std::nullopt;
+    }
+    try
+    {
+        BinaryReader r((*buffer)->getBuffer());
+        r.readHeader(entryMagic);
+
+        // Check whether any of the files changed
+        for (auto n = r.readInteger(); n--;)
+        {
+            std::string path = r.readString();
+            std::uint64_t hash = r.readInteger();
+            if (contentHash(path) != hash)
+            {
+                ++misses_;
+                return std::nullopt;
+            }
+        }
+
+        Entry entry;
+        for (auto n = r.readInteger(); n--;)
+        {
+            std::string msg = r.readString();
+            if (r.readBool())
+            {
+                entry.diags.error(std::move(msg));
+            }
+            else
+            {
+                entry.diags.warn(std::move(msg));
+            }
+        }
+        entry.info = r.readInfoSet();
+        ++hits_;
+        return entry;
+    }
+    catch (Exception const& ex)
+    {
+        report::debug("Ignoring cache entry {}: {}", key, ex.error());
+        ++misses_;
+        return std::nullopt;
+    }
+}
+
+Expected<void>
+ExtractionCache::
+store(
+    std::string_view key,
+    std::vector<std::string> const& files,
+    InfoSet const& info,
+    Diagnostics const& diags)
+{
+    std::string data;
+    BinaryWriter w(data);
+    w.writeHeader(entryMagic);
+
+    w.writeInteger(files.size());
+    for (std::string const& path : files)
+    {
+        auto hash = contentHash(path);
+        if (!hash)
+        {
+            return Unexpected(formatError(
+                "Failed to read \"{}\"", path));
+        }
+        w.writeString(path);
+        w.writeInteger(*hash);
+    }
+
+    auto const& messages = diags.messages();
+    w.writeInteger(messages.size());
+    for (auto const& [msg, is_error] : messages)
+    {
+        w.writeString(msg);
+        w.writeBool(is_error);
+    }
+
+    w.writeInfoSet(info);
+
+    // Write to a temporary file and rename it so that
+    // concurrent runs never observe a partial entry
+    if (auto err = llvm::writeToOutput(entryPath(key),
+        [&](llvm::raw_ostream& os)
+        {
+            os << data;
+            return llvm::Error::success();
+        }))
+    {
+        return Unexpected(toError(std::move(err)));
+    }
+    return {};
+}
+
+//------------------------------------------------
+
+void
+CachingExecutionContext::
+report(
+    InfoSet&& info,
+    Diagnostics&& diags)
+{
+    if (auto exp = cache_.store(key_, files_, info, diags); !exp)
+    {
+        report::warn("Failed to store cache entry: {}", exp.error());
+    }
+    next_.report(std::move(info), std::move(diags));
+}
+
+void
+CachingExecutionContext::
+reportFiles(
+    std::vector<std::string> const& files)
+{
+    files_ = files;
+}
+
+void
+CachingExecutionContext::
+reportEnd(report::Level level)
+{
+    next_.reportEnd(level);
+}
+
+mrdocs::Expected<InfoSet>
+CachingExecutionContext::
+results()
+{
+    return next_.results();
+}
+
+} // mrdocs
+} // clang
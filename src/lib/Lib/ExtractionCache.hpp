@@ -0,0 +1,194 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_EXTRACTIONCACHE_HPP
+#define MRDOCS_LIB_LIB_EXTRACTIONCACHE_HPP
+
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/Diagnostics.hpp"
+#include "lib/Lib/ExecutionContext.hpp"
+#include "lib/Lib/Info.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** A persistent cache of the symbols extracted from each translation unit.
+
+    Each entry holds the `InfoSet` and `Diagnostics`
+    produced by visiting one translation unit, along
+    with the content hash of the main file and of
+    every file it included.
+
+    Entries are keyed on the compile command of the
+    translation unit, the extraction settings of the
+    configuration, and the version of MrDocs. An entry
+    is only used when the contents of all of the files
+    it depends on are unchanged, in which case the
+    translation unit does not need to be parsed again.
+*/
+class ExtractionCache
+{
+    std::string dir_;
+    std::string settingsKey_;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::uint64_t> contentHashes_;
+
+    std::atomic<std::size_t> hits_ = 0;
+    std::atomic<std::size_t> misses_ = 0;
+
+    std::optional<std::uint64_t>
+    contentHash(std::string const& path);
+
+    std::string
+    entryPath(std::string_view key) const;
+
+public:
+    /** The cached results of a translation unit.
+    */
+    struct Entry
+    {
+        InfoSet info;
+        Diagnostics diags;
+    };
+
+    /** Constructor.
+
+        @param dir The directory where cache
+        entries are stored. It is created
+        if it does not exist.
+
+        @param config The configuration, whose
+        extraction settings become part of every key.
+    */
+    ExtractionCache(
+        std::string_view dir,
+        ConfigImpl const& config);
+
+    /** Return the key for a translation unit.
+
+        @param cmds The compile commands for the
+        main file of the translation unit, as returned
+        by the compilation database.
+    */
+    std::string
+    key(std::vector<tooling::CompileCommand> const& cmds) const;
+
+    /** Return the cached results for a key.
+
+        @return The cached results, or `std::nullopt`
+        if there is no entry for the key, the entry
+        cannot be read, or any of the files the
+        translation unit depends on has changed.
+    */
+    std::optional<Entry>
+    load(std::string_view key);
+
+    /** Store the results of a translation unit.
+
+        @param key The key returned by @ref key.
+        @param files The full paths of the files
+        the translation unit depends on.
+        @param info The extracted symbols.
+        @param diags The diagnostics.
+    */
+    Expected<void>
+    store(
+        std::string_view key,
+        std::vector<std::string> const& files,
+        InfoSet const& info,
+        Diagnostics const& diags);
+
+    /** Return the number of entries used.
+    */
+    std::size_t
+    hits() const noexcept
+    {
+        return hits_;
+    }
+
+    /** Return the number of translation units not found in the cache.
+    */
+    std::size_t
+    misses() const noexcept
+    {
+        return misses_;
+    }
+};
+
+//------------------------------------------------
+
+/** An execution context which stores results in an ExtractionCache.
+
+    The results of the translation unit are
+    written to the cache and then forwarded
+    to another execution context.
+*/
+class CachingExecutionContext
+    : public ExecutionContext
+{
+    ExecutionContext& next_;
+    ExtractionCache& cache_;
+    std::string key_;
+    std::vector<std::string> files_;
+
+public:
+    /** Constructor.
+
+        @param config The configuration to use.
+        @param next The execution context the results are forwarded to.
+        @param cache The cache to store the results in.
+        @param key The cache key of the translation unit.
+    */
+    CachingExecutionContext(
+        ConfigImpl const& config,
+        ExecutionContext& next,
+        ExtractionCache& cache,
+        std::string key)
+        : ExecutionContext(config)
+        , next_(next)
+        , cache_(cache)
+        , key_(std::move(key))
+    {
+    }
+
+    /// @copydoc ExecutionContext::report
+    void
+    report(
+        InfoSet&& info,
+        Diagnostics&& diags) override;
+
+    /// @copydoc ExecutionContext::reportFiles
+    void
+    reportFiles(
+        std::vector<std::string> const& files) override;
+
+    /// @copydoc ExecutionContext::reportEnd
+    void
+    reportEnd(report::Level level) override;
+
+    /// @copydoc ExecutionContext::results
+    mrdocs::Expected<InfoSet>
+    results() override;
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -0,0 +1,42 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "ExtractionRegistry.hpp"
+#include <mutex>
+
+namespace clang {
+namespace mrdocs {
+
+bool
+ExtractionRegistry::
+contains(Definition const& def) const
+{
+    Shard const& shard = shards_[shardIndex(def.first)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.hashes.find(def.first);
+    return it != shard.hashes.end() && it->second == def.second;
+}
+
+void
+ExtractionRegistry::
+insert(std::span<Definition const> defs)
+{
+    for (auto const& [id, hash] : defs)
+    {
+        Shard& shard = shards_[shardIndex(id)];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // The first definition wins, so that a
+        // conflicting one is always extracted
+        shard.hashes.try_emplace(id, hash);
+    }
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,101 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_EXTRACTIONREGISTRY_HPP
+#define MRDOCS_LIB_LIB_EXTRACTIONREGISTRY_HPP
+
+#include <mrdocs/Metadata/Symbols.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+
+namespace clang {
+namespace mrdocs {
+
+/** The definitions already extracted by any translation unit.
+
+    Public headers are included by many translation
+    units, and each of them would otherwise extract
+    the same records and enums again, only for the
+    duplicates to be merged away.
+
+    A definition is identified by its `SymbolID`
+    together with its ODR hash, so that a header
+    whose contents differ between translation units,
+    for example because of macros, is not skipped.
+
+    Translation units publish their definitions only
+    after their results have been reported, so that a
+    definition is never skipped unless its symbols are
+    already part of the corpus.
+*/
+class ExtractionRegistry
+{
+public:
+    /** A definition, as a symbol ID and its ODR hash.
+    */
+    using Definition = std::pair<SymbolID, std::uint64_t>;
+
+    /** Return true if a definition was extracted.
+    */
+    bool
+    contains(Definition const& def) const;
+
+    /** Add the definitions extracted by a translation unit.
+    */
+    void
+    insert(std::span<Definition const> defs);
+
+    /** Record definitions skipped by a translation unit.
+    */
+    void
+    addSkipped(std::size_t n) noexcept
+    {
+        skipped_ += n;
+    }
+
+    /** Return the number of definitions skipped.
+    */
+    std::size_t
+    skipped() const noexcept
+    {
+        return skipped_.load();
+    }
+
+private:
+    static constexpr std::size_t shardCount = 64;
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<SymbolID, std::uint64_t> hashes;
+    };
+
+    std::array<Shard, shardCount> shards_;
+    std::atomic<std::size_t> skipped_ = 0;
+
+    static
+    std::size_t
+    shardIndex(SymbolID const& id) noexcept
+    {
+        // SymbolIDs are hashes, so any byte
+        // is uniformly distributed
+        return id.data()[19] % shardCount;
+    }
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -15,105 +15,28 @@ namespace mrdocs {
 
 FilterPattern::
 FilterPattern()
+    : glob_("*")
 {
-#ifndef NDEBUG
-    // pattern for VS debugger visualizers
-    pattern_.push_back('*');
-#endif
 }
 
 FilterPattern::
 FilterPattern(
     std::string_view pattern)
+    : glob_(pattern)
 {
-    while(! pattern.empty())
+    raw_.reserve(pattern.size());
+    for(char c : pattern)
     {
-        bool wildcard = pattern.front() == '*';
-        std::size_t part_size = std::min(
-            pattern.size(), wildcard ?
-                pattern.find_first_not_of('*') :
-                pattern.find('*'));
-
-        if(! wildcard)
-            raw_.append(pattern, 0, part_size);
-
-        #ifndef NDEBUG
-            // pattern for VS debugger visualizers
-            pattern_.append(wildcard ?
-                "*" : pattern.substr(0, part_size));
-        #endif
-
-        pattern.remove_prefix(part_size);
-
-        // don't store the parts for patterns without
-        // wildcards, as well as wildcard only patterns
-        if(pattern.empty() && parts_.empty())
-            break;
-
-        parts_.push_back(wildcard ? 0 : part_size);
-    }
-}
-
-bool
-FilterPattern::
-matchesSlow(
-    std::string_view str,
-    std::string_view pattern,
-    std::span<const std::size_t> parts) const
-{
-    MRDOCS_ASSERT(! parts.empty());
-    const auto& part = pattern.substr(0, parts[0]);
-    pattern.remove_prefix(parts[0]);
-    parts = parts.subspan(1);
-    // current part is not a wild card
-    if(! part.empty())
-    {
-        // every character in the pattern must
-        // match the beginning of the string
-        if(! str.starts_with(part))
-            return false;
-        str.remove_prefix(part.size());
-        // if there are no other parts, then we only
-        // have a match if there are no characters left
-        if(parts.empty())
-            return str.empty();
-        // if we had a match and the pattern ends in
-        // a wildcard, the entire string matches
-        if(parts.size() == 1)
-            return true;
-        return matchesSlow(str, pattern, parts);
+        if(c != '*')
+            raw_.push_back(c);
     }
-    // current part is a wildcard.
-    // check all possible lengths for this wildcard until we
-    // either find a match, or we run out of characters.
-    for(; ! str.empty(); str.remove_prefix(1))
-    {
-        if(matchesSlow(str, pattern, parts))
-            return true;
-    }
-    return false;
 }
 
 bool
 FilterPattern::
 matches(std::string_view str) const
 {
-    if(parts_.empty())
-    {
-        // if the raw pattern is empty, the pattern is '*'
-        // and matches everything
-        if(raw_.empty())
-            return true;
-        // the pattern contains no wildcards, compare with
-        // the raw pattern
-        return str == raw_;
-    }
-    // no match when the string is shorter than
-    // the shortest possible match size
-    if(str.size() < raw_.size())
-        return false;
-    // otherwise, use the wildcard matching algorithm
-    return matchesSlow(str, raw_, parts_);
+    return glob_.matches(str);
 }
 
 bool
@@ -11,6 +11,7 @@
 #ifndef MRDOCS_LIB_FILTERS_HPP
 #define MRDOCS_LIB_FILTERS_HPP
 
+#include "lib/Support/Glob.hpp"
 #include <mrdocs/Platform.hpp>
 #include <span>
 #include <string>
@@ -22,26 +23,10 @@ namespace mrdocs {
 
 class FilterPattern
 {
+    // compiled pattern
+    GlobPattern glob_;
     // pattern without any wildcards
     std::string raw_;
-    // pattern part lengths, where zero represents a wildcard
-    std::vector<std::size_t> parts_;
-
-#ifndef NDEBUG
-    // pattern string for VS debugger visualizers
-    std::string pattern_;
-#endif
-
-    /** Returns whether a string matches the multi-component pattern.
-
-        This function implements matching for patterns which contain
-        multiple components (i.e. both literal strings and wildcards).
-    */
-    bool
-    matchesSlow(
-        std::string_view str,
-        std::string_view pattern,
-        std::span<const std::size_t> parts) const;
 
 public:
     FilterPattern();
@@ -10,6 +10,8 @@
 
 #include "Lookup.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <algorithm>
+#include <functional>
 
 namespace clang {
 namespace mrdocs {
@@ -43,7 +45,7 @@ void
 buildLookups(
     const Corpus& corpus,
     const Info& info,
-    LookupTable& lookups)
+    std::vector<std::pair<std::string_view, const Info*>>& lookups)
 {
     visit(info, [&]<typename InfoTy>(const InfoTy& I)
     {
@@ -64,7 +66,7 @@ buildLookups(
                 // KRYSTIAN TODO: injected class names?
                 if(child->Name.empty())
                     continue;
-                lookups.add(child->Name, child);
+                lookups.emplace_back(child->Name, child);
             }
         }
     });
@@ -79,25 +81,88 @@ LookupTable(
 {
     MRDOCS_ASSERT(supportsLookup(&info));
 
-    buildLookups(corpus, info, *this);
+    std::vector<std::pair<std::string_view, const Info*>> lookups;
+    buildLookups(corpus, info, lookups);
+
+    // group the symbols by name, keeping
+    // the order of the symbols of each name
+    std::ranges::stable_sort(lookups, {},
+        &std::pair<std::string_view, const Info*>::first);
+    std::size_t names = 0;
+    for(std::size_t i = 0; i < lookups.size(); ++i)
+    {
+        if(i == 0 || lookups[i].first != lookups[i - 1].first)
+            ++names;
+    }
+
+    std::size_t size = 2;
+    while(size < 2 * names)
+        size *= 2;
+    slots_.resize(size);
+    infos_.reserve(lookups.size());
+    std::size_t const mask = size - 1;
+    for(std::size_t i = 0; i < lookups.size();)
+    {
+        std::string_view const name = lookups[i].first;
+        std::size_t h = std::hash<std::string_view>()(name) & mask;
+        while(slots_[h].count != 0)
+            h = (h + 1) & mask;
+        Slot& slot = slots_[h];
+        slot.name = name;
+        slot.first = static_cast<std::uint32_t>(infos_.size());
+        for(; i < lookups.size() && lookups[i].first == name; ++i)
+            infos_.push_back(lookups[i].second);
+        slot.count = static_cast<std::uint32_t>(
+            infos_.size() - slot.first);
+    }
+}
+
+std::span<const Info* const>
+LookupTable::
+lookup(std::string_view name) const noexcept
+{
+    std::size_t const mask = slots_.size() - 1;
+    std::size_t h = std::hash<std::string_view>()(name) & mask;
+    for(;; h = (h + 1) & mask)
+    {
+        Slot const& slot = slots_[h];
+        if(slot.count == 0)
+            return {};
+        if(slot.name == name)
+            return std::span(infos_).subspan(slot.first, slot.count);
+    }
 }
 
 SymbolLookup::
 SymbolLookup(const Corpus& corpus)
     : corpus_(corpus)
 {
+    lookup_tables_.reserve(corpus_.size());
     for(const Info& I : corpus_)
     {
         if(! supportsLookup(&I))
             continue;
-        lookup_tables_.emplace(&I, LookupTable(I, corpus_));
+        lookup_tables_.try_emplace(&I);
     }
 }
 
+LookupTable const&
+SymbolLookup::
+getTable(const Info* context) const
+{
+    LazyTable const& lazy = lookup_tables_.at(context);
+    std::call_once(lazy.once, [&]
+    {
+        lazy.table.emplace(*context, corpus_);
+        ++tablesBuilt_;
+    });
+    return *lazy.table;
+}
+
 const Info*
 SymbolLookup::
 adjustLookupContext(
-    const Info* context)
+    const Info* context) const
 {
     // find the innermost enclosing context that supports name lookup
     while(! supportsLookup(context))
@@ -111,7 +176,7 @@ adjustLookupContext(
 
 const Info*
 SymbolLookup::
-lookThroughTypedefs(const Info* I)
+lookThroughTypedefs(const Info* I) const
 {
     if(! I || ! I->isTypedef())
         return I;
@@ -126,14 +191,14 @@ lookupInContext(
     const Info* context,
     std::string_view name,
     bool for_nns,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     // if the lookup context is a typedef, we want to
     // lookup the name in the type it denotes
     if(! (context = lookThroughTypedefs(context)))
         return nullptr;
     MRDOCS_ASSERT(supportsLookup(context));
-    LookupTable& table = lookup_tables_.at(context);
+    LookupTable const& table = getTable(context);
     // KRYSTIAN FIXME: disambiguation based on signature
     for(auto& result : table.lookup(name))
     {
@@ -185,7 +250,7 @@ lookupUnqualifiedImpl(
     const Info* context,
     std::string_view name,
     bool for_nns,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     if(! context)
         return nullptr;
@@ -209,7 +274,7 @@ lookupQualifiedImpl(
     const Info* context,
     std::span<const std::string_view> qualifier,
     std::string_view terminal,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     if(! context)
         return nullptr;
@@ -14,12 +14,16 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
-#include <ranges>
 #include <unordered_map>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -30,35 +34,55 @@ class LookupTable
     // names from member symbols which are "transparent"
     // (e.g. unscoped enums and inline namespaces) will
     // have their members added to the table as well
-    std::unordered_multimap<
-        std::string_view, const Info*> lookups_;
+    struct Slot
+    {
+        std::string_view name;
+        std::uint32_t first = 0;
+        std::uint32_t count = 0;
+    };
+
+    // the symbols, grouped by name
+    std::vector<const Info*> infos_;
+
+    // an open addressing table with linear probing,
+    // whose size is a power of two. A slot with
+    // no symbols is empty.
+    std::vector<Slot> slots_;
 
 public:
     LookupTable(
         const Info& info,
         const Corpus& corpus);
 
-    auto lookup(std::string_view name) const
-    {
-        auto [first, last] = lookups_.equal_range(name);
-        return std::ranges::subrange(
-            first, last) | std::views::values;
-    }
-
-    void add(std::string_view name, const Info* info)
-    {
-        lookups_.emplace(name, info);
-    }
+    /** Return the symbols with a name, in the order they were declared.
+    */
+    std::span<const Info* const>
+    lookup(std::string_view name) const noexcept;
 };
 
 class SymbolLookup
 {
     const Corpus& corpus_;
 
-    // maps symbol ID to its lookup table, if lookup is supported
+    // the lookup table of a symbol, built
+    // the first time the symbol is searched
+    struct LazyTable
+    {
+        mutable std::once_flag once;
+        mutable std::optional<LookupTable> table;
+    };
+
+    // maps each symbol which supports lookup to its table.
+    // The map itself is never modified after construction,
+    // so tables can be built concurrently.
     std::unordered_map<
         const Info*,
-        LookupTable> lookup_tables_;
+        LazyTable> lookup_tables_;
+
+    mutable std::atomic<std::size_t> tablesBuilt_ = 0;
+
+    LookupTable const&
+    getTable(const Info* context) const;
 
     struct LookupCallback
     {
@@ -67,48 +91,70 @@ class SymbolLookup
     };
 
     template<typename Fn>
-    auto makeHandler(Fn& fn);
+    auto makeHandler(Fn& fn) const;
 
-    const Info*
-    adjustLookupContext(const Info* context);
 
     const Info*
-    lookThroughTypedefs(const Info* I);
+    lookThroughTypedefs(const Info* I) const;
 
     const Info*
     getTypeAsTag(
-        const std::unique_ptr<TypeInfo>& T);
+        const std::unique_ptr<TypeInfo>& T) const;
 
     const Info*
     lookupInContext(
         const Info* context,
         std::string_view name,
         bool for_nns,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
     const Info*
     lookupUnqualifiedImpl(
         const Info* context,
         std::string_view name,
         bool for_nns,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
     const Info*
     lookupQualifiedImpl(
         const Info* context,
         std::span<const std::string_view> qualifier,
         std::string_view terminal,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
 public:
     SymbolLookup(const Corpus& corpus);
 
+    /** Return the innermost enclosing symbol which supports lookup.
+
+        Unqualified lookups from `context` start
+        in this symbol.
+    */
+    const Info*
+    adjustLookupContext(const Info* context) const;
+
+    /** Return the number of lookup tables built.
+    */
+    std::size_t
+    tablesBuilt() const noexcept
+    {
+        return tablesBuilt_;
+    }
+
+    /** Return the number of symbols which support lookup.
+    */
+    std::size_t
+    tableCount() const noexcept
+    {
+        return lookup_tables_.size();
+    }
+
     template<typename Fn>
     const Info*
     lookupUnqualified(
         const Info* context,
         std::string_view name,
-        Fn&& callback)
+        Fn&& callback) const
     {
         auto handler = makeHandler(callback);
         return lookupUnqualifiedImpl(
@@ -121,7 +167,7 @@ public:
         const Info* context,
         std::span<const std::string_view> qualifier,
         std::string_view terminal,
-        Fn&& callback)
+        Fn&& callback) const
     {
         auto handler = makeHandler(callback);
         return lookupQualifiedImpl(
@@ -132,7 +178,7 @@ public:
 template<typename Fn>
 auto
 SymbolLookup::
-makeHandler(Fn& fn)
+makeHandler(Fn& fn) const
 {
     class LookupCallbackImpl
         : public LookupCallback
@@ -18,6 +18,7 @@
 #include <clang/Driver/Driver.h>
 #include <clang/Driver/Options.h>
 #include <clang/Driver/Types.h>
+#include <clang/Tooling/ArgumentsAdjusters.h>
 #include <llvm/Option/ArgList.h>
 #include <llvm/Option/OptTable.h>
 #include <llvm/Support/FileSystem.h>
@@ -477,5 +478,33 @@ getAllCompileCommands() const
     return AllCommands_;
 }
 
+std::vector<std::string>
+normalizedCommandLine(
+    tooling::CompileCommand const& cmd)
+{
+    tooling::CommandLineArguments args = tooling::combineAdjusters(
+        tooling::getClangSyntaxOnlyAdjuster(),
+        tooling::combineAdjusters(
+            tooling::getClangStripOutputAdjuster(),
+            tooling::getClangStripDependencyFileAdjuster()))(
+                cmd.CommandLine, cmd.Filename);
+
+    std::string const file = files::normalizePath(
+        files::makeAbsolute(cmd.Filename, cmd.Directory));
+    std::vector<std::string> result;
+    result.reserve(args.size());
+    for (std::string& arg : args)
+    {
+        if (!result.empty() && !arg.starts_with('-') &&
+            files::normalizePath(files::makeAbsolute(
+                arg, cmd.Directory)) == file)
+        {
+            continue;
+        }
+        result.emplace_back(std::move(arg));
+    }
+    return result;
+}
+
 } // mrdocs
 } // clang
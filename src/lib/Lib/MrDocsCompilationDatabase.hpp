@@ -82,6 +82,19 @@ public:
     getAllCompileCommands() const override;
 };
 
+/** Return the arguments of a compile command without its source file.
+
+    The output, the dependency file and the flags
+    which select the compiler action are removed,
+    so that the commands of files compiled with the
+    same options compare equal.
+
+    @param cmd The compile command.
+*/
+std::vector<std::string>
+normalizedCommandLine(
+    tooling::CompileCommand const& cmd);
+
 } // mrdocs
 } // clang
 
@@ -0,0 +1,510 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "SharedPCH.hpp"
+#include "lib/Lib/MrDocsCompilationDatabase.hpp"
+#include "lib/Support/Error.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/FileManager.h>
+#include <clang/Driver/Driver.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/MultiplexConsumer.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <ranges>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+/** Marks implicit instantiations as implicit.
+
+    This does for the precompiled header what
+    the consumer of the translation units does,
+    since the flag is stored with the declarations.
+*/
+class ImplicitInstantiationConsumer
+    : public ASTConsumer
+{
+    void
+    HandleCXXStaticMemberVarInstantiation(VarDecl* D) override
+    {
+        D->setImplicit();
+    }
+
+    void
+    HandleCXXImplicitFunctionInstantiation(FunctionDecl* D) override
+    {
+        D->setImplicit();
+    }
+};
+
+/** Builds a precompiled header the way translation units are parsed.
+*/
+class PrecompileAction
+    : public GeneratePCHAction
+{
+    bool
+    BeginSourceFileAction(CompilerInstance& CI) override
+    {
+        CI.getFrontendOpts().SkipFunctionBodies = true;
+        return GeneratePCHAction::BeginSourceFileAction(CI);
+    }
+
+    std::unique_ptr<ASTConsumer>
+    CreateASTConsumer(
+        CompilerInstance& CI,
+        llvm::StringRef InFile) override
+    {
+        std::unique_ptr<ASTConsumer> generator =
+            GeneratePCHAction::CreateASTConsumer(CI, InFile);
+        if (!generator)
+        {
+            return nullptr;
+        }
+        std::vector<std::unique_ptr<ASTConsumer>> consumers;
+        consumers.emplace_back(
+            std::make_unique<ImplicitInstantiationConsumer>());
+        consumers.emplace_back(std::move(generator));
+        return std::make_unique<MultiplexConsumer>(
+            std::move(consumers));
+    }
+};
+
+std::string_view
+trim(std::string_view s) noexcept
+{
+    auto const isSpace = [](char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+    };
+    while (!s.empty() && isSpace(s.front()))
+    {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && isSpace(s.back()))
+    {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+/** Return the `#include` lines at the beginning of a source file.
+
+    Blank lines, comments and `#pragma once` are
+    skipped. The sequence ends at the first line
+    which is anything else, since other directives
+    may change the meaning of later includes.
+*/
+std::vector<std::string>
+leadingIncludes(std::string_view text)
+{
+    std::vector<std::string> result;
+    bool inComment = false;
+    while (!text.empty())
+    {
+        std::size_t const eol = std::min(text.find('\n'), text.size());
+        std::string_view line = trim(text.substr(0, eol));
+        text.remove_prefix(std::min(eol + 1, text.size()));
+
+        if (inComment)
+        {
+            std::size_t const end = line.find("*/");
+            if (end == std::string_view::npos)
+            {
+                continue;
+            }
+            inComment = false;
+            line = trim(line.substr(end + 2));
+        }
+        while (line.starts_with("/*"))
+        {
+            std::size_t const end = line.find("*/", 2);
+            if (end == std::string_view::npos)
+            {
+                inComment = true;
+                line = {};
+                break;
+            }
+            line = trim(line.substr(end + 2));
+        }
+        if (line.empty() || line.starts_with("//"))
+        {
+            continue;
+        }
+        if (!line.starts_with('#') || line.ends_with('\\'))
+        {
+            break;
+        }
+        std::string_view const directive = trim(line.substr(1));
+        if (directive == "pragma once")
+        {
+            continue;
+        }
+        if (!directive.starts_with("include") ||
+            directive.starts_with("include_next"))
+        {
+            break;
+        }
+        result.emplace_back(line);
+    }
+    return result;
+}
+
+/** Return the arguments to precompile a header for a compile command.
+
+    The source file, the output and the syntax-only
+    flag are removed. No arguments are returned for
+    the MSVC driver mode, which has other options.
+*/
+std::vector<std::string>
+precompileArgs(tooling::CompileCommand const& cmd)
+{
+    if (cmd.CommandLine.empty())
+    {
+        return {};
+    }
+    std::vector<char const*> argv;
+    argv.reserve(cmd.CommandLine.size());
+    for (std::string const& arg : cmd.CommandLine)
+    {
+        argv.push_back(arg.c_str());
+    }
+    if (driver::IsClangCL(driver::getDriverMode(argv.front(), argv)))
+    {
+        return {};
+    }
+
+    std::vector<std::string> result;
+    for (std::string& arg : normalizedCommandLine(cmd))
+    {
+        if (arg != "-fsyntax-only")
+        {
+            result.emplace_back(std::move(arg));
+        }
+    }
+    return result;
+}
+
+} // (anon)
+
+SharedPCH::
+SharedPCH(SharedFileSystemCache& fsCache) noexcept
+    : fsCache_(fsCache)
+{
+}
+
+SharedPCH::
+~SharedPCH()
+{
+    if (!dir_.empty())
+    {
+        llvm::sys::fs::remove_directories(dir_);
+    }
+}
+
+void
+SharedPCH::
+build(
+    tooling::CompilationDatabase const& compilations,
+    std::vector<std::string> const& files,
+    ThreadPool& threadPool)
+{
+    // Group the files by compile command. Quoted
+    // includes are searched relative to the source
+    // file first, so the directory of the file is
+    // part of the group too.
+    struct Candidate
+    {
+        std::vector<std::string> args;
+        std::string directory;
+        std::string parent;
+        std::vector<std::string const*> files;
+    };
+    std::map<std::string, Candidate> candidates;
+    for (std::string const& file : files)
+    {
+        std::vector<tooling::CompileCommand> cmds =
+            compilations.getCompileCommands(file);
+        if (cmds.size() != 1)
+        {
+            continue;
+        }
+        std::vector<std::string> args = precompileArgs(cmds.front());
+        if (args.empty())
+        {
+            continue;
+        }
+        std::string parent = files::getParentDir(
+            files::makeAbsolute(cmds.front().Filename,
+                cmds.front().Directory));
+        std::string key = cmds.front().Directory;
+        key += '\0';
+        key += parent;
+        for (std::string const& arg : args)
+        {
+            key += '\0';
+            key += arg;
+        }
+        Candidate& candidate = candidates[std::move(key)];
+        if (candidate.files.empty())
+        {
+            candidate.args = std::move(args);
+            candidate.directory = cmds.front().Directory;
+            candidate.parent = std::move(parent);
+        }
+        candidate.files.push_back(&file);
+    }
+
+    // Find the includes common to all the files of each group
+    auto fs = llvm::vfs::getRealFileSystem();
+    for (auto& [key, candidate] : candidates)
+    {
+        if (candidate.files.size() < 2)
+        {
+            continue;
+        }
+        std::optional<std::vector<std::string>> common;
+        for (std::string const* file : candidate.files)
+        {
+            auto contents = fsCache_.contents(files::makeAbsolute(
+                *file, candidate.directory), *fs);
+            if (!contents)
+            {
+                common.emplace();
+                break;
+            }
+            std::vector<std::string> includes =
+                leadingIncludes((*contents)->buffer->getBuffer());
+            if (!common)
+            {
+                common = std::move(includes);
+                continue;
+            }
+            auto const [it, _] = std::ranges::mismatch(*common, includes);
+            common->erase(it, common->end());
+            if (common->empty())
+            {
+                break;
+            }
+        }
+        if (!common || common->empty())
+        {
+            continue;
+        }
+
+        auto group = std::make_unique<Group>();
+        group->includes = std::move(*common);
+        group->args = std::move(candidate.args);
+        group->args.emplace_back("-iquote");
+        group->args.emplace_back(candidate.parent);
+        group->args.emplace_back("-fretain-comments-from-system-headers");
+        group->directory = std::move(candidate.directory);
+        group->files = candidate.files.size();
+        for (std::string const* file : candidate.files)
+        {
+            groupOf_.emplace(*file, group.get());
+        }
+        groups_.emplace_back(std::move(group));
+    }
+    if (groups_.empty())
+    {
+        return;
+    }
+
+    // The headers are created in the temporary directory,
+    // rather than the working directory of the process
+    llvm::SmallString<128> prefix;
+    llvm::sys::path::system_temp_directory(true, prefix);
+    llvm::sys::path::append(prefix, "mrdocs-pch");
+    llvm::SmallString<128> dir;
+    if (auto ec = llvm::sys::fs::createUniqueDirectory(prefix, dir))
+    {
+        report::warn("Failed to create a directory for precompiled headers: {}",
+            ec.message());
+        groupOf_.clear();
+        return;
+    }
+    dir_ = std::string(dir);
+
+    TaskGroup taskGroup(threadPool);
+    for (std::size_t i = 0; i < groups_.size(); ++i)
+    {
+        taskGroup.async([this, i]
+        {
+            buildOne(*groups_[i], i);
+        });
+    }
+    for (Error const& err : taskGroup.wait())
+    {
+        report::warn("Failed to build a precompiled header: {}", err);
+    }
+
+    // Files whose header failed to build are parsed without one
+    std::erase_if(groupOf_, [](auto const& entry)
+    {
+        return !entry.second->built;
+    });
+}
+
+void
+SharedPCH::
+buildOne(Group& group, std::size_t index)
+{
+    // Write a header which includes the common prefix
+    std::string const header = files::appendPath(
+        dir_, fmt::format("pch-{}.hpp", index));
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(header, ec);
+        if (ec)
+        {
+            report::debug("Failed to write \"{}\": {}", header, ec.message());
+            return;
+        }
+        for (std::string const& line : group.includes)
+        {
+            os << line << '\n';
+        }
+    }
+    group.path = files::appendPath(
+        dir_, fmt::format("pch-{}.pch", index));
+
+    std::vector<std::string> args = group.args;
+    args.emplace_back("-x");
+    args.emplace_back("c++-header");
+    args.emplace_back(header);
+    args.emplace_back("-o");
+    args.emplace_back(group.path);
+
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS =
+        createCachingFileSystem(fsCache_);
+    if (auto ec = FS->setCurrentWorkingDirectory(group.directory))
+    {
+        report::debug("Failed to set the working directory \"{}\": {}",
+            group.directory, ec.message());
+        return;
+    }
+    IntrusiveRefCntPtr<FileManager> fileManager(
+        new FileManager(FileSystemOptions(), FS));
+    IgnoringDiagConsumer diags;
+    tooling::ToolInvocation invocation(
+        std::move(args),
+        std::make_unique<PrecompileAction>(),
+        fileManager.get());
+    invocation.setDiagnosticConsumer(&diags);
+
+    auto const start = clock_type::now();
+    if (!invocation.run())
+    {
+        report::debug("Failed to precompile the includes of {} files",
+            group.files);
+        return;
+    }
+    group.buildTime = clock_type::now() - start;
+    group.built = true;
+}
+
+auto
+SharedPCH::
+find(std::string const& file) const ->
+    Group const*
+{
+    auto it = groupOf_.find(file);
+    if (it == groupOf_.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+std::vector<std::string>
+SharedPCH::
+includeArgs(Group const& group)
+{
+    // Options stored in the header must match
+    // those of the translation unit
+    return {
+        "-include-pch",
+        group.path,
+        "-fretain-comments-from-system-headers" };
+}
+
+void
+SharedPCH::
+addHit(Group const& group) noexcept
+{
+    ++hits_;
+    usedTime_ += group.buildTime.count();
+}
+
+void
+SharedPCH::
+addMiss() noexcept
+{
+    ++misses_;
+}
+
+void
+SharedPCH::
+addFallback() noexcept
+{
+    ++fallbacks_;
+}
+
+std::size_t
+SharedPCH::
+builtCount() const noexcept
+{
+    return std::ranges::count_if(groups_,
+        [](auto const& group)
+        {
+            return group->built;
+        });
+}
+
+auto
+SharedPCH::
+buildTime() const noexcept ->
+    clock_type::duration
+{
+    clock_type::duration total{};
+    for (auto const& group : groups_)
+    {
+        total += group->buildTime;
+    }
+    return total;
+}
+
+auto
+SharedPCH::
+savedTime() const noexcept ->
+    clock_type::duration
+{
+    clock_type::duration const used(usedTime_.load());
+    clock_type::duration const built = buildTime();
+    if (used <= built)
+    {
+        return {};
+    }
+    return used - built;
+}
+
+} // mrdocs
+} // clang
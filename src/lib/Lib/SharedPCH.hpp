@@ -0,0 +1,168 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_SHAREDPCH_HPP
+#define MRDOCS_LIB_LIB_SHAREDPCH_HPP
+
+#include "lib/Lib/CachingFileSystem.hpp"
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** Precompiled headers shared by translation units.
+
+    Source files compiled with the same flags from
+    the same directory usually begin with the same
+    includes. The files are grouped by compile
+    command and directory, and the longest sequence
+    of `#include` lines common to the beginning of
+    every file of a group is compiled once into a
+    precompiled header.
+
+    Each translation unit of a group then loads the
+    precompiled header before its own contents, and
+    the include guards of the headers skip them when
+    they are included again.
+*/
+class SharedPCH
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** A precompiled header built for a group of files.
+    */
+    struct Group
+    {
+        // the included lines, in order
+        std::vector<std::string> includes;
+
+        // the arguments used to build the header
+        std::vector<std::string> args;
+
+        // the working directory of the compile command
+        std::string directory;
+
+        // the path of the precompiled header
+        std::string path;
+
+        // the time taken to build the header, which
+        // estimates the time saved by each use
+        clock_type::duration buildTime{};
+
+        std::size_t files = 0;
+        bool built = false;
+    };
+
+    /** Constructor.
+
+        @param fsCache The cache of files used
+        to build the precompiled headers.
+    */
+    explicit
+    SharedPCH(SharedFileSystemCache& fsCache) noexcept;
+
+    /** Destructor.
+
+        The precompiled headers are deleted.
+    */
+    ~SharedPCH();
+
+    /** Build the precompiled headers for a set of files.
+
+        Groups of fewer than two files, and groups
+        without common includes, are ignored. A group
+        whose precompiled header fails to build is
+        parsed without it.
+    */
+    void
+    build(
+        tooling::CompilationDatabase const& compilations,
+        std::vector<std::string> const& files,
+        ThreadPool& threadPool);
+
+    /** Return the precompiled header for a file, or nullptr.
+    */
+    Group const*
+    find(std::string const& file) const;
+
+    /** Return the arguments which load a precompiled header.
+    */
+    static
+    std::vector<std::string>
+    includeArgs(Group const& group);
+
+    /** Record that a file was parsed with its precompiled header.
+    */
+    void
+    addHit(Group const& group) noexcept;
+
+    /** Record that a file was parsed without a precompiled header.
+    */
+    void
+    addMiss() noexcept;
+
+    /** Record that a file failed with its precompiled header.
+
+        The file is then parsed again without it.
+    */
+    void
+    addFallback() noexcept;
+
+    std::uint64_t hits() const noexcept { return hits_; }
+    std::uint64_t misses() const noexcept { return misses_; }
+    std::uint64_t fallbacks() const noexcept { return fallbacks_; }
+
+    /** Return the number of precompiled headers built.
+    */
+    std::size_t
+    builtCount() const noexcept;
+
+    /** Return the total time spent building precompiled headers.
+    */
+    clock_type::duration
+    buildTime() const noexcept;
+
+    /** Return the estimated time saved by the precompiled headers.
+
+        This is the time taken to build the header of
+        each file which used one, less the time taken
+        to build the headers, or zero if negative.
+    */
+    clock_type::duration
+    savedTime() const noexcept;
+
+private:
+    SharedFileSystemCache& fsCache_;
+    std::string dir_;
+    std::vector<std::unique_ptr<Group>> groups_;
+    std::unordered_map<std::string, Group const*> groupOf_;
+    std::atomic<std::uint64_t> hits_ = 0;
+    std::atomic<std::uint64_t> misses_ = 0;
+    std::atomic<std::uint64_t> fallbacks_ = 0;
+    std::atomic<clock_type::rep> usedTime_ = 0;
+
+    void
+    buildOne(Group& group, std::size_t index);
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -0,0 +1,162 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "TimingProfile.hpp"
+#include "lib/Support/Error.hpp"
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <charconv>
+#include <numeric>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+/** Return the estimated cost of a file with no recorded time.
+
+    Each directly included file is assumed to
+    contribute as much as a few kilobytes of
+    the main file.
+*/
+double
+estimateCost(std::string const& file)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(
+        file, false, false);
+    if (!buffer)
+    {
+        return 0;
+    }
+    llvm::StringRef text = (*buffer)->getBuffer();
+    std::size_t const includes = text.count("#include");
+    constexpr std::size_t bytesPerInclude = 8192;
+    return static_cast<double>(text.size() + includes * bytesPerInclude);
+}
+
+} // (anon)
+
+TimingProfile
+TimingProfile::
+load(std::string_view path)
+{
+    TimingProfile profile;
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer)
+    {
+        return profile;
+    }
+    // Each line is the time in milliseconds
+    // followed by a space and the file path
+    llvm::StringRef text = (*buffer)->getBuffer();
+    while (!text.empty())
+    {
+        llvm::StringRef line;
+        std::tie(line, text) = text.split('\n');
+        auto [ms, file] = line.split(' ');
+        std::chrono::milliseconds::rep count = 0;
+        auto [ptr, ec] = std::from_chars(ms.begin(), ms.end(), count);
+        if (ec != std::errc() || ptr != ms.end() || file.empty())
+        {
+            continue;
+        }
+        profile.times_.emplace(file.str(), std::chrono::milliseconds(count));
+    }
+    return profile;
+}
+
+Expected<void>
+TimingProfile::
+store(std::string_view path) const
+{
+    if (auto err = llvm::writeToOutput(path,
+        [&](llvm::raw_ostream& os)
+        {
+            for (auto const& [file, time] : times_)
+            {
+                os << time.count() << ' ' << file << '\n';
+            }
+            return llvm::Error::success();
+        }))
+    {
+        return Unexpected(toError(std::move(err)));
+    }
+    return {};
+}
+
+void
+TimingProfile::
+record(
+    std::string const& file,
+    std::chrono::milliseconds time)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    times_.insert_or_assign(file, time);
+}
+
+std::vector<std::size_t>
+TimingProfile::
+schedule(std::vector<std::string> const& files) const
+{
+    std::vector<double> costs(files.size());
+    std::vector<std::size_t> recorded;
+    std::vector<std::size_t> unrecorded;
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        auto it = times_.find(files[i]);
+        if (it != times_.end())
+        {
+            costs[i] = static_cast<double>(it->second.count());
+            recorded.push_back(i);
+        }
+        else
+        {
+            unrecorded.push_back(i);
+        }
+    }
+
+    if (!unrecorded.empty())
+    {
+        // Express the estimates in milliseconds so they
+        // are comparable with recorded times. Only a
+        // sample of the recorded files is read for this.
+        constexpr std::size_t maxSamples = 32;
+        std::size_t const step =
+            (recorded.size() + maxSamples - 1) / maxSamples;
+        double totalTime = 0;
+        double totalEstimate = 0;
+        for (std::size_t j = 0; j < recorded.size(); j += step)
+        {
+            std::size_t const i = recorded[j];
+            totalTime += costs[i];
+            totalEstimate += estimateCost(files[i]);
+        }
+        double const scale = totalEstimate > 0 ?
+            totalTime / totalEstimate : 1.0;
+        for (std::size_t i : unrecorded)
+        {
+            costs[i] = estimateCost(files[i]) * scale;
+        }
+    }
+
+    std::vector<std::size_t> order(files.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order,
+        [&](std::size_t a, std::size_t b)
+        {
+            return costs[a] > costs[b];
+        });
+    return order;
+}
+
+} // mrdocs
+} // clang
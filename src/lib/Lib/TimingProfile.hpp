@@ -0,0 +1,87 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_TIMINGPROFILE_HPP
+#define MRDOCS_LIB_LIB_TIMINGPROFILE_HPP
+
+#include <mrdocs/Support/Error.hpp>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** The time taken to extract each translation unit.
+
+    The profile is recorded during extraction and
+    persisted between runs, so that the largest
+    translation units can be scheduled first and
+    the thread pool is not left waiting on a single
+    large translation unit at the end of the build.
+*/
+class TimingProfile
+{
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::chrono::milliseconds> times_;
+
+public:
+    /** Load a profile from a file.
+
+        If the file does not exist, the
+        profile is empty.
+    */
+    static
+    TimingProfile
+    load(std::string_view path);
+
+    /** Write the profile to a file.
+    */
+    Expected<void>
+    store(std::string_view path) const;
+
+    TimingProfile() = default;
+
+    TimingProfile(TimingProfile&& other) noexcept
+        : times_(std::move(other.times_))
+    {
+    }
+
+    /** Record the time taken to extract a translation unit.
+    */
+    void
+    record(
+        std::string const& file,
+        std::chrono::milliseconds time);
+
+    /** Return the indices of the files in the order they should be processed.
+
+        Files are ordered by decreasing cost.
+        Files with a recorded time use that time as
+        their cost. Other files are estimated from
+        the size of the file and the number of
+        `#include` directives it contains, scaled to
+        match the recorded times of a sample of the
+        other files when any exist. Files are only
+        read when some file has no recorded time.
+
+        @param files The full paths of the main files.
+    */
+    std::vector<std::size_t>
+    schedule(std::vector<std::string> const& files) const;
+};
+
+} // mrdocs
+} // clang
+
+#endif
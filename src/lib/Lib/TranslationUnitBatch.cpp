@@ -0,0 +1,277 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "TranslationUnitBatch.hpp"
+#include "lib/Lib/MrDocsCompilationDatabase.hpp"
+#include "lib/Support/Error.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <clang/Driver/Types.h>
+#include <llvm/Support/Path.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <span>
+#include <unordered_set>
+#include <utility>
+
+namespace clang {
+namespace mrdocs {
+
+std::vector<TranslationUnitBatch>
+makeBatches(
+    tooling::CompilationDatabase const& compilations,
+    std::vector<std::string>& files,
+    std::size_t maxSize)
+{
+    std::vector<TranslationUnitBatch> batches;
+    if (maxSize < 2)
+    {
+        return batches;
+    }
+
+    // Group the files by directory and command line
+    struct Group
+    {
+        tooling::CompileCommand command;
+        std::vector<std::string> args;
+        std::vector<std::string const*> files;
+    };
+    std::map<std::string, Group> groups;
+    for (std::string const& file : files)
+    {
+        std::vector<tooling::CompileCommand> cmds =
+            compilations.getCompileCommands(file);
+        if (cmds.size() != 1)
+        {
+            continue;
+        }
+        std::vector<std::string> args = normalizedCommandLine(cmds.front());
+        std::string key = cmds.front().Directory;
+        for (std::string const& arg : args)
+        {
+            key += '\0';
+            key += arg;
+        }
+        Group& group = groups[std::move(key)];
+        if (group.files.empty())
+        {
+            group.command = std::move(cmds.front());
+            group.args = std::move(args);
+        }
+        group.files.push_back(&file);
+    }
+
+    std::unordered_set<std::string> batched;
+    for (auto& [key, group] : groups)
+    {
+        for (std::size_t i = 0; i + 1 < group.files.size(); i += maxSize)
+        {
+            std::size_t const n = std::min(maxSize, group.files.size() - i);
+            TranslationUnitBatch batch;
+            batch.path = files::appendPath(group.command.Directory,
+                fmt::format("mrdocs-batch-{}.cpp", batches.size()));
+            for (std::string const* file : std::span(group.files).subspan(i, n))
+            {
+                // Quoted includes in each file are still searched
+                // relative to that file, since it is the includer
+                batch.contents += fmt::format("#include \"{}\"\n",
+                    files::makePosixStyle(files::makeAbsolute(
+                        *file, group.command.Directory)));
+                batch.files.push_back(*file);
+                batched.insert(*file);
+            }
+            batch.command.Directory = group.command.Directory;
+            batch.command.Filename = batch.path;
+            batch.command.CommandLine = group.args;
+            batch.command.CommandLine.push_back(batch.path);
+            batches.push_back(std::move(batch));
+        }
+    }
+
+    std::erase_if(files, [&](std::string const& file)
+    {
+        return batched.contains(file);
+    });
+    return batches;
+}
+
+namespace {
+
+bool
+isHeaderFile(std::string_view path)
+{
+    driver::types::ID const id = driver::types::lookupTypeForExtension(
+        llvm::sys::path::extension(path).drop_front());
+    return id == driver::types::TY_CHeader ||
+        id == driver::types::TY_CXXHeader;
+}
+
+} // (anon)
+
+std::vector<std::string>
+findInputHeaders(ConfigImpl const& config)
+{
+    std::vector<std::string> roots = config->input.include;
+    if (roots.empty())
+    {
+        roots.push_back(config->sourceRoot);
+    }
+
+    std::vector<std::string> headers;
+    for (std::string const& root : roots)
+    {
+        Error err = forEachFile(root, true,
+            [&](std::string_view path) -> Error
+            {
+                std::string const posixPath = files::makePosixStyle(path);
+                bool const matches = config->filePatternFilter.empty() ?
+                    isHeaderFile(path) :
+                    std::ranges::any_of(config->filePatternFilter,
+                        [&](GlobPattern const& pattern)
+                        {
+                            return pattern.matches(posixPath);
+                        });
+                if (!matches)
+                {
+                    return Error::success();
+                }
+                auto const type = files::getFileType(path);
+                if (type && *type == files::FileType::regular)
+                {
+                    headers.emplace_back(path);
+                }
+                return Error::success();
+            });
+        if (err)
+        {
+            report::warn("Failed to list the headers in \"{}\": {}",
+                root, err);
+        }
+    }
+    std::ranges::sort(headers);
+    auto const [first, last] = std::ranges::unique(headers);
+    headers.erase(first, last);
+    return headers;
+}
+
+std::vector<TranslationUnitBatch>
+makeHeaderBatches(
+    tooling::CompilationDatabase const& compilations,
+    std::vector<std::string> const& headers,
+    std::size_t maxSize)
+{
+    std::vector<TranslationUnitBatch> batches;
+
+    // Find the most common command line
+    std::map<std::string, std::size_t> counts;
+    std::optional<tooling::CompileCommand> command;
+    std::size_t best = 0;
+    for (tooling::CompileCommand& cmd : compilations.getAllCompileCommands())
+    {
+        std::string key = cmd.Directory;
+        for (std::string const& arg : normalizedCommandLine(cmd))
+        {
+            key += '\0';
+            key += arg;
+        }
+        if (std::size_t const n = ++counts[std::move(key)]; n > best)
+        {
+            best = n;
+            command = std::move(cmd);
+        }
+    }
+    if (!command || headers.empty())
+    {
+        return batches;
+    }
+    std::vector<std::string> const args = normalizedCommandLine(*command);
+
+    if (maxSize < 2)
+    {
+        maxSize = headers.size();
+    }
+    for (std::size_t i = 0; i < headers.size(); i += maxSize)
+    {
+        std::size_t const n = std::min(maxSize, headers.size() - i);
+        TranslationUnitBatch batch;
+        batch.path = files::appendPath(command->Directory,
+            fmt::format("mrdocs-headers-{}.cpp", batches.size()));
+        for (std::string const& header : std::span(headers).subspan(i, n))
+        {
+            batch.contents += fmt::format("#include \"{}\"\n",
+                files::makePosixStyle(header));
+            batch.files.push_back(header);
+        }
+        batch.command.Directory = command->Directory;
+        batch.command.Filename = batch.path;
+        batch.command.CommandLine = args;
+        batch.command.CommandLine.push_back(batch.path);
+        batches.push_back(std::move(batch));
+    }
+    return batches;
+}
+
+//------------------------------------------------
+
+BatchCompilationDatabase::
+BatchCompilationDatabase(
+    tooling::CompilationDatabase const& inner,
+    std::vector<TranslationUnitBatch> const& batches)
+    : inner_(inner)
+{
+    for (TranslationUnitBatch const& batch : batches)
+    {
+        batches_.emplace(batch.path, batch.command);
+        for (std::string const& file : batch.files)
+        {
+            if (!inner_.getCompileCommands(file).empty())
+            {
+                continue;
+            }
+            tooling::CompileCommand cmd = batch.command;
+            cmd.Filename = file;
+            cmd.CommandLine.back() = "-x";
+            cmd.CommandLine.emplace_back("c++");
+            cmd.CommandLine.push_back(file);
+            batches_.emplace(file, std::move(cmd));
+        }
+    }
+}
+
+std::vector<tooling::CompileCommand>
+BatchCompilationDatabase::
+getCompileCommands(
+    llvm::StringRef FilePath) const
+{
+    auto it = batches_.find(FilePath.str());
+    if (it != batches_.end())
+    {
+        return { it->second };
+    }
+    return inner_.getCompileCommands(FilePath);
+}
+
+std::vector<std::string>
+BatchCompilationDatabase::
+getAllFiles() const
+{
+    return inner_.getAllFiles();
+}
+
+std::vector<tooling::CompileCommand>
+BatchCompilationDatabase::
+getAllCompileCommands() const
+{
+    return inner_.getAllCompileCommands();
+}
+
+} // mrdocs
+} // clang
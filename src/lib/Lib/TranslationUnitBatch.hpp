@@ -0,0 +1,127 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_TRANSLATIONUNITBATCH_HPP
+#define MRDOCS_LIB_LIB_TRANSLATIONUNITBATCH_HPP
+
+#include "lib/Lib/ConfigImpl.hpp"
+#include <clang/Tooling/CompilationDatabase.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** A translation unit which includes several source files.
+
+    The source of the translation unit only exists
+    in memory, and consists of an `#include`
+    directive for each file, in order.
+*/
+struct TranslationUnitBatch
+{
+    /** The path of the translation unit.
+    */
+    std::string path;
+
+    /** The source of the translation unit.
+    */
+    std::string contents;
+
+    /** The compile command of the translation unit.
+    */
+    tooling::CompileCommand command;
+
+    /** The source files included by the translation unit.
+    */
+    std::vector<std::string> files;
+};
+
+/** Group source files into batches.
+
+    Files compiled with the same normalized command
+    line from the same directory are combined, up to
+    `maxSize` files per batch. The files which are
+    part of a batch are removed from `files`.
+
+    @param compilations The compilation database.
+    @param files The source files.
+    @param maxSize The maximum number of files in a batch.
+*/
+std::vector<TranslationUnitBatch>
+makeBatches(
+    tooling::CompilationDatabase const& compilations,
+    std::vector<std::string>& files,
+    std::size_t maxSize);
+
+/** Return the input headers, in order.
+
+    These are the files under the input directories,
+    or under the source root when there are none,
+    which match the input file patterns. Without
+    file patterns, every header is returned.
+
+    @param config The configuration.
+*/
+std::vector<std::string>
+findInputHeaders(ConfigImpl const& config);
+
+/** Group headers into umbrella batches.
+
+    Each batch includes up to `maxSize` headers, or
+    all of them when `maxSize` is less than two.
+    The batches are compiled with the most common
+    command line of the compilation database.
+
+    @param compilations The compilation database.
+    @param headers The headers.
+    @param maxSize The maximum number of headers in a batch.
+*/
+std::vector<TranslationUnitBatch>
+makeHeaderBatches(
+    tooling::CompilationDatabase const& compilations,
+    std::vector<std::string> const& headers,
+    std::size_t maxSize);
+
+/** A compilation database which includes batches.
+
+    The compile commands of the batches are returned
+    for their paths, and those of the inner database
+    for any other file. A file of a batch which has
+    no compile command, such as a header, is compiled
+    as C++ with the command of its batch.
+*/
+class BatchCompilationDatabase
+    : public tooling::CompilationDatabase
+{
+    tooling::CompilationDatabase const& inner_;
+    std::unordered_map<std::string, tooling::CompileCommand> batches_;
+
+public:
+    BatchCompilationDatabase(
+        tooling::CompilationDatabase const& inner,
+        std::vector<TranslationUnitBatch> const& batches);
+
+    std::vector<tooling::CompileCommand>
+    getCompileCommands(
+        llvm::StringRef FilePath) const override;
+
+    std::vector<std::string>
+    getAllFiles() const override;
+
+    std::vector<tooling::CompileCommand>
+    getAllCompileCommands() const override;
+};
+
+} // mrdocs
+} // clang
+
+#endif
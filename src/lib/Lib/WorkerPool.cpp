@@ -0,0 +1,640 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "WorkerPool.hpp"
+#include "lib/Metadata/Serialize.hpp"
+#include "lib/Support/Error.hpp"
+#include "lib/Support/Stats.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace clang {
+namespace mrdocs {
+
+#if !defined(_WIN32)
+
+namespace {
+
+/** Collects the serialized results of a task in a worker.
+*/
+class ResultWriter
+    : public ExecutionContext
+{
+    std::string data_;
+    std::size_t count_ = 0;
+
+public:
+    using ExecutionContext::ExecutionContext;
+
+    void
+    report(
+        InfoSet&& info,
+        Diagnostics&& diags) override
+    {
+        BinaryWriter w(data_);
+        auto const& messages = diags.messages();
+        w.writeInteger(messages.size());
+        for (auto const& [msg, is_error] : messages)
+        {
+            w.writeString(msg);
+            w.writeBool(is_error);
+        }
+        w.writeInfoSet(info);
+        ++count_;
+    }
+
+    void
+    reportEnd(report::Level) override
+    {
+    }
+
+    mrdocs::Expected<InfoSet>
+    results() override
+    {
+        return InfoSet();
+    }
+
+    std::size_t
+    count() const noexcept
+    {
+        return count_;
+    }
+
+    std::string const&
+    data() const noexcept
+    {
+        return data_;
+    }
+};
+
+/** Write the statistics recorded by a worker since the last task.
+
+    They are removed from the worker, and
+    recorded by the parent process.
+*/
+void
+writeStats(BinaryWriter& w)
+{
+    auto const translationUnits = Stats::get().takeTranslationUnits();
+    w.writeInteger(translationUnits.size());
+    for (Stats::TranslationUnit const& tu : translationUnits)
+    {
+        w.writeString(tu.file);
+        for (Stats::duration d : {
+            tu.preprocess, tu.parse, tu.traverse,
+            tu.dependencies, tu.symbolIds, tu.queueWait })
+        {
+            w.writeInteger(static_cast<std::uint64_t>(d.count()));
+        }
+    }
+    auto const counters = Stats::get().takeCounters();
+    w.writeInteger(counters.size());
+    for (auto const& [name, n] : counters)
+    {
+        w.writeString(name);
+        w.writeInteger(n);
+    }
+}
+
+void
+disableSigPipe([[maybe_unused]] int fd) noexcept
+{
+#if defined(SO_NOSIGPIPE)
+    int const on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+bool
+writeAll(int fd, char const* data, std::size_t size) noexcept
+{
+#if defined(MSG_NOSIGNAL)
+    constexpr int flags = MSG_NOSIGNAL;
+#else
+    constexpr int flags = 0;
+#endif
+    while (size != 0)
+    {
+        ssize_t const n = send(fd, data, size, flags);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool
+readAll(int fd, char* data, std::size_t size) noexcept
+{
+    while (size != 0)
+    {
+        ssize_t const n = read(fd, data, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// Messages are prefixed with their size as
+// eight little endian bytes
+bool
+writeMessage(int fd, std::string_view data) noexcept
+{
+    char header[8];
+    std::uint64_t size = data.size();
+    for (char& c : header)
+    {
+        c = static_cast<char>(size & 0xff);
+        size >>= 8;
+    }
+    return writeAll(fd, header, sizeof(header)) &&
+        writeAll(fd, data.data(), data.size());
+}
+
+bool
+readMessage(int fd, std::string& data)
+{
+    unsigned char header[8];
+    if (!readAll(fd, reinterpret_cast<char*>(header), sizeof(header)))
+    {
+        return false;
+    }
+    std::uint64_t size = 0;
+    for (std::size_t i = sizeof(header); i-- != 0;)
+    {
+        size = (size << 8) | header[i];
+    }
+    data.resize(size);
+    return readAll(fd, data.data(), data.size());
+}
+
+/** Send a file descriptor over a socket.
+
+    A negative descriptor is sent as a message
+    without one, to report a failure.
+*/
+bool
+sendSocket(int fd, int socket) noexcept
+{
+    char byte = socket < 0 ? 'e' : 's';
+    iovec iov{ &byte, 1 };
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    if (socket >= 0)
+    {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &socket, sizeof(int));
+    }
+    while (sendmsg(fd, &msg, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Receive a file descriptor sent with sendSocket.
+
+    @return The descriptor, or -1 on failure.
+*/
+int
+receiveSocket(int fd) noexcept
+{
+    char byte = 0;
+    iovec iov{ &byte, 1 };
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    ssize_t n;
+    while ((n = recvmsg(fd, &msg, 0)) < 0 && errno == EINTR)
+    {
+    }
+    if (n != 1 || byte != 's')
+    {
+        return -1;
+    }
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg ||
+        cmsg->cmsg_level != SOL_SOCKET ||
+        cmsg->cmsg_type != SCM_RIGHTS)
+    {
+        return -1;
+    }
+    int socket = -1;
+    std::memcpy(&socket, CMSG_DATA(cmsg), sizeof(int));
+    return socket;
+}
+
+} // (anon)
+
+#endif
+
+WorkerPool::
+WorkerPool(
+    ConfigImpl const& config,
+    Task task,
+    std::size_t maxWorkers,
+    std::size_t maxTasks,
+    std::size_t maxMemory)
+    : config_(config)
+    , task_(std::move(task))
+    , maxWorkers_(std::max<std::size_t>(maxWorkers, 1))
+    , maxTasks_(maxTasks)
+    , maxMemory_(maxMemory)
+{
+}
+
+WorkerPool::
+~WorkerPool()
+{
+#if !defined(_WIN32)
+    // Idle workers exit when their socket is
+    // closed, and the spawner when its own is
+    for (int socket : idle_)
+    {
+        close(socket);
+    }
+    if (spawnerSocket_ >= 0)
+    {
+        close(spawnerSocket_);
+    }
+    if (spawnerPid_ > 0)
+    {
+        while (waitpid(spawnerPid_, nullptr, 0) < 0 && errno == EINTR)
+        {
+        }
+    }
+#endif
+}
+
+Expected<void>
+WorkerPool::
+start()
+{
+#if defined(_WIN32)
+    return Unexpected(formatError(
+        "Worker processes are not supported on this platform"));
+#else
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+        return Unexpected(formatError(
+            "Failed to create a socket: {}", std::strerror(errno)));
+    }
+    disableSigPipe(fds[0]);
+    pid_t const pid = fork();
+    if (pid < 0)
+    {
+        int const err = errno;
+        close(fds[0]);
+        close(fds[1]);
+        return Unexpected(formatError(
+            "Failed to start the worker spawner: {}", std::strerror(err)));
+    }
+    if (pid == 0)
+    {
+        close(fds[0]);
+        spawnerSocket_ = fds[1];
+        runSpawner();
+    }
+    close(fds[1]);
+    spawnerPid_ = pid;
+    spawnerSocket_ = fds[0];
+    return {};
+#endif
+}
+
+Expected<void>
+WorkerPool::
+run(
+    std::string_view request,
+    ExecutionContext& context)
+{
+#if defined(_WIN32)
+    return Unexpected(formatError(
+        "Worker processes are not supported on this platform"));
+#else
+    MRDOCS_TRY(int const socket, acquire());
+
+    std::string reply;
+    if (!writeMessage(socket, request) ||
+        !readMessage(socket, reply))
+    {
+        release(socket, false);
+        ++crashes_;
+        return Unexpected(formatError("The worker process terminated"));
+    }
+
+    // Decode the whole reply before reporting
+    // anything, so that a malformed reply does
+    // not report partial results
+    bool retire = false;
+    std::string error;
+    std::vector<std::pair<InfoSet, Diagnostics>> results;
+    std::vector<Stats::TranslationUnit> translationUnits;
+    std::vector<std::pair<std::string, std::uint64_t>> counters;
+    try
+    {
+        BinaryReader r(reply);
+        retire = r.readBool();
+        if (!r.readBool())
+        {
+            error = r.readString();
+        }
+        auto n = r.readInteger();
+        while (n--)
+        {
+            Diagnostics diags;
+            auto m = r.readInteger();
+            while (m--)
+            {
+                std::string msg = r.readString();
+                if (r.readBool())
+                {
+                    diags.error(std::move(msg));
+                }
+                else
+                {
+                    diags.warn(std::move(msg));
+                }
+            }
+            InfoSet info = r.readInfoSet();
+            results.emplace_back(std::move(info), std::move(diags));
+        }
+        n = r.readInteger();
+        while (n--)
+        {
+            Stats::TranslationUnit& tu = translationUnits.emplace_back();
+            tu.file = r.readString();
+            for (Stats::duration* d : {
+                &tu.preprocess, &tu.parse, &tu.traverse,
+                &tu.dependencies, &tu.symbolIds, &tu.queueWait })
+            {
+                *d = Stats::duration(
+                    static_cast<Stats::duration::rep>(r.readInteger()));
+            }
+        }
+        n = r.readInteger();
+        while (n--)
+        {
+            std::string name = r.readString();
+            counters.emplace_back(std::move(name), r.readInteger());
+        }
+    }
+    catch (Exception const& ex)
+    {
+        release(socket, false);
+        return Unexpected(formatError(
+            "Invalid reply from a worker process: {}", ex.error()));
+    }
+
+    if (retire)
+    {
+        ++recycled_;
+    }
+    release(socket, !retire);
+    for (auto& tu : translationUnits)
+    {
+        Stats::get().addTranslationUnit(std::move(tu));
+    }
+    for (auto const& [name, n] : counters)
+    {
+        Stats::get().addCounter(name, n);
+    }
+    for (auto& [info, diags] : results)
+    {
+        context.report(std::move(info), std::move(diags));
+    }
+    if (!error.empty())
+    {
+        return Unexpected(Error(std::move(error)));
+    }
+    return {};
+#endif
+}
+
+#if !defined(_WIN32)
+
+Expected<int>
+WorkerPool::
+acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]
+    {
+        return !idle_.empty() || workers_ < maxWorkers_;
+    });
+    if (!idle_.empty())
+    {
+        int const socket = idle_.back();
+        idle_.pop_back();
+        return socket;
+    }
+
+    // The spawner socket is shared, so the
+    // request is made while holding the lock
+    char const byte = 's';
+    int socket = -1;
+    if (writeAll(spawnerSocket_, &byte, 1))
+    {
+        socket = receiveSocket(spawnerSocket_);
+    }
+    if (socket < 0)
+    {
+        return Unexpected(formatError("Failed to start a worker process"));
+    }
+    disableSigPipe(socket);
+    ++workers_;
+    return socket;
+}
+
+void
+WorkerPool::
+release(int socket, bool alive)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (alive)
+        {
+            idle_.push_back(socket);
+        }
+        else
+        {
+            close(socket);
+            --workers_;
+        }
+    }
+    cv_.notify_one();
+}
+
+void
+WorkerPool::
+runSpawner()
+{
+    // Workers are reaped automatically, since
+    // the parent detects their end on their socket
+    std::signal(SIGCHLD, SIG_IGN);
+
+    char byte;
+    while (readAll(spawnerSocket_, &byte, 1))
+    {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+        {
+            sendSocket(spawnerSocket_, -1);
+            continue;
+        }
+        pid_t const pid = fork();
+        if (pid == 0)
+        {
+            close(spawnerSocket_);
+            close(fds[0]);
+            std::signal(SIGCHLD, SIG_DFL);
+            runWorker(fds[1]);
+        }
+        sendSocket(spawnerSocket_, pid < 0 ? -1 : fds[0]);
+        close(fds[0]);
+        close(fds[1]);
+    }
+    _exit(0);
+}
+
+void
+WorkerPool::
+runWorker(int socket)
+{
+    disableSigPipe(socket);
+
+    // The statistics inherited from the parent
+    // are already recorded there
+    Stats::get().takeTranslationUnits();
+    Stats::get().takeCounters();
+
+    // The peak resident memory is inherited from the
+    // parent too, so the growth of the current resident
+    // memory since the fork is what is limited
+    std::uint64_t const baseline = currentResidentBytes();
+    std::size_t tasks = 0;
+    std::string request;
+    while (readMessage(socket, request))
+    {
+        ResultWriter context(config_);
+        std::string error;
+        try
+        {
+            task_(request, context);
+        }
+        catch (Exception const& ex)
+        {
+            error = ex.error().reason();
+        }
+        catch (std::exception const& ex)
+        {
+            error = ex.what();
+        }
+        ++tasks;
+        std::uint64_t const resident = currentResidentBytes();
+        bool const retire =
+            (maxTasks_ != 0 && tasks >= maxTasks_) ||
+            (maxMemory_ != 0 && resident > baseline &&
+                resident - baseline >= (maxMemory_ << 20));
+
+        std::string reply;
+        BinaryWriter w(reply);
+        w.writeBool(retire);
+        w.writeBool(error.empty());
+        if (!error.empty())
+        {
+            w.writeString(error);
+        }
+        w.writeInteger(context.count());
+        reply += context.data();
+        writeStats(w);
+        if (!writeMessage(socket, reply) || retire)
+        {
+            break;
+        }
+    }
+    // The state inherited from the parent
+    // is not destroyed
+    _exit(0);
+}
+
+#else
+
+Expected<int>
+WorkerPool::
+acquire()
+{
+    return Unexpected(formatError(
+        "Worker processes are not supported on this platform"));
+}
+
+void
+WorkerPool::
+release(int, bool)
+{
+}
+
+void
+WorkerPool::
+runSpawner()
+{
+    MRDOCS_UNREACHABLE();
+}
+
+void
+WorkerPool::
+runWorker(int)
+{
+    MRDOCS_UNREACHABLE();
+}
+
+#endif
+
+} // mrdocs
+} // clang
@@ -0,0 +1,166 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_WORKERPOOL_HPP
+#define MRDOCS_LIB_LIB_WORKERPOOL_HPP
+
+#include "lib/Lib/ExecutionContext.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** A pool of worker processes which run extraction tasks.
+
+    Each worker is a separate process, so that the
+    allocations of one worker do not fragment the
+    heap of the others, and a crash only loses the
+    task which was running.
+
+    The workers are forked from a spawner process,
+    itself forked by @ref start while no other thread
+    is running. This way the workers are created
+    from a single threaded process and start with
+    a copy of the state of the extraction, without
+    inheriting the locks held by other threads.
+
+    A worker runs many tasks, and is replaced after
+    a number of tasks, or once its peak memory
+    passes a limit. The results of each task are
+    serialized and reported to an execution context
+    of the parent process, and the statistics it
+    recorded are added to those of the parent.
+
+    Worker processes are only supported on POSIX
+    systems.
+*/
+class WorkerPool
+{
+public:
+    /** A task run by a worker.
+
+        The function reports the results of the request
+        to the context, and throws an @ref Exception
+        on failure.
+    */
+    using Task = std::function<
+        void(std::string_view request, ExecutionContext& context)>;
+
+    /** Constructor.
+
+        @param config The configuration.
+        @param task The task run by the workers.
+        @param maxWorkers The maximum number of workers.
+        @param maxTasks The number of tasks after which a
+        worker is replaced, or zero for no limit.
+        @param maxMemory The growth of the resident
+        memory of a worker in megabytes after which
+        it is replaced, or zero for no limit.
+    */
+    WorkerPool(
+        ConfigImpl const& config,
+        Task task,
+        std::size_t maxWorkers,
+        std::size_t maxTasks,
+        std::size_t maxMemory);
+
+    /** Destructor.
+
+        The workers and the spawner are stopped.
+    */
+    ~WorkerPool();
+
+    /** Start the spawner process.
+
+        This must be called while no other thread
+        of the process holds a lock, since the
+        workers inherit the state of the process
+        at this point.
+    */
+    Expected<void>
+    start();
+
+    /** Run a task on a worker.
+
+        This blocks until a worker is available
+        and the task has completed, and may be
+        called concurrently.
+
+        @return An error if the task failed or
+        the worker terminated.
+    */
+    Expected<void>
+    run(
+        std::string_view request,
+        ExecutionContext& context);
+
+    /** Return the number of workers which terminated during a task.
+    */
+    std::size_t
+    crashes() const noexcept
+    {
+        return crashes_;
+    }
+
+    /** Return the number of workers replaced after reaching a limit.
+    */
+    std::size_t
+    recycled() const noexcept
+    {
+        return recycled_;
+    }
+
+private:
+    ConfigImpl const& config_;
+    Task task_;
+    std::size_t maxWorkers_;
+    std::size_t maxTasks_;
+    std::size_t maxMemory_;
+
+    // the spawner process
+    int spawnerPid_ = -1;
+    int spawnerSocket_ = -1;
+
+    // the sockets of the idle workers
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<int> idle_;
+    std::size_t workers_ = 0;
+
+    std::atomic<std::size_t> crashes_ = 0;
+    std::atomic<std::size_t> recycled_ = 0;
+
+    Expected<int>
+    acquire();
+
+    void
+    release(int socket, bool alive);
+
+    [[noreturn]]
+    void
+    runSpawner();
+
+    [[noreturn]]
+    void
+    runWorker(int socket);
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -16,6 +16,7 @@
 #include <llvm/ADT/StringMap.h>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <variant>
 
 namespace clang {
@@ -88,42 +89,49 @@ domCreate(
 
 class DomOverloadsArray : public dom::ArrayImpl
 {
-    std::vector<std::variant<
-        SymbolID, OverloadSet>> overloads_;
-
+    // The groups were computed when
+    // the scope was finalized
+    ScopeInfo const& scope_;
+    std::shared_ptr<Tranche> sp_; // keep owner of scope_ alive
     DomCorpus const& domCorpus_;
 
 public:
-    template<std::derived_from<ScopeInfo> ScopeInfoTy>
     DomOverloadsArray(
-        const ScopeInfoTy& I,
+        ScopeInfo const& I,
         DomCorpus const& domCorpus) noexcept
-        : domCorpus_(domCorpus)
+        : scope_(I)
+        , domCorpus_(domCorpus)
+    {
+    }
+
+    DomOverloadsArray(
+        ScopeInfo const& I,
+        std::shared_ptr<Tranche> const& sp,
+        DomCorpus const& domCorpus) noexcept
+        : scope_(I)
+        , sp_(sp)
+        , domCorpus_(domCorpus)
     {
-        overloads_.reserve(I.Lookups.size());
-        domCorpus_->traverseOverloads(I,
-            [&](const auto& C)
-        {
-            if constexpr(requires { C.id; })
-                overloads_.emplace_back(C.id);
-            else
-                overloads_.emplace_back(C);
-        });
     }
 
     std::size_t size() const noexcept override
     {
-        return overloads_.size();
+        return scope_.OverloadGroups.size();
     }
 
     dom::Value get(std::size_t index) const override
     {
         MRDOCS_ASSERT(index < size());
-        const auto& member = overloads_[index];
-        if(auto* id = std::get_if<SymbolID>(&member))
-            return domCorpus_.get(*id);
-        return domCorpus_.getOverloads(
-            std::get<OverloadSet>(member));
+        OverloadGroup const& group = scope_.OverloadGroups[index];
+        if(group.Count == 0)
+            return domCorpus_.get(group.Member);
+        Info const& member = domCorpus_->get(group.Member);
+        return domCorpus_.getOverloads(OverloadSet(
+            member.Name,
+            member.Namespace.front(),
+            member.Namespace,
+            std::span(scope_.OverloadMembers).subspan(
+                group.First, group.Count)));
     }
 };
 
@@ -139,8 +147,8 @@ dom::Object
 domCreate(Location const& loc)
 {
     return dom::Object({
-        { "path",       loc.Path },
-        { "file",       loc.Filename },
+        { "path",       loc.path() },
+        { "file",       loc.filename() },
         { "line",       loc.LineNumber },
         { "kind",       toString(loc.Kind) },
         { "documented", loc.Documented }
@@ -611,9 +619,10 @@ class DomTranche : public dom::DefaultObjectImpl
     dom::Value
     init(
         const ScopeInfo& scope,
+        std::shared_ptr<Tranche> const& tranche,
         DomCorpus const& domCorpus)
     {
-        return dom::newArray<DomOverloadsArray>(scope, domCorpus);
+        return dom::newArray<DomOverloadsArray>(scope, tranche, domCorpus);
     }
 
 public:
@@ -626,8 +635,8 @@ public:
             #include <mrdocs/Metadata/InfoNodes.inc>
             { "types",            init(tranche->Types, domCorpus) },
             { "staticfuncs",      init(tranche->StaticFunctions, domCorpus) },
-            { "overloads",        init(tranche->Overloads, domCorpus) },
-            { "staticoverloads",  init(tranche->StaticOverloads, domCorpus) },
+            { "overloads",        init(tranche->Overloads, tranche, domCorpus) },
+            { "staticoverloads",  init(tranche->StaticOverloads, tranche, domCorpus) },
             })
         , tranche_(tranche)
         , domCorpus_(domCorpus)
@@ -915,6 +924,163 @@ DomInfo<T>::construct() const
     return dom::Object(std::move(entries));
 }
 
+//------------------------------------------------
+//
+// Indexes
+//
+//------------------------------------------------
+
+class DomInfoArray : public dom::ArrayImpl
+{
+    std::span<Info const* const> list_;
+    DomCorpus const& domCorpus_;
+
+public:
+    DomInfoArray(
+        std::span<Info const* const> list,
+        DomCorpus const& domCorpus) noexcept
+        : list_(list)
+        , domCorpus_(domCorpus)
+    {
+    }
+
+    std::size_t size() const noexcept override
+    {
+        return list_.size();
+    }
+
+    dom::Value get(std::size_t i) const override
+    {
+        MRDOCS_ASSERT(i < list_.size());
+        return domCorpus_.get(list_[i]->id);
+    }
+};
+
+/** An index of the corpus as a Dom object.
+
+    The arrays of symbols are created on demand,
+    by querying the corpus with the property name.
+    The object is shared by all the contexts of a
+    generator, so it is read-only.
+*/
+class DomIndexObject : public dom::ObjectImpl
+{
+public:
+    enum class Key
+    {
+        Kind,
+        Name,
+        File
+    };
+
+private:
+    Key key_;
+    DomCorpus const& domCorpus_;
+
+    // The names of the kinds with symbols, or
+    // the names or files indexed by the corpus
+    std::vector<dom::String> kinds_;
+    std::span<std::string_view const> keys_;
+
+    std::span<Info const* const>
+    find(std::string_view key) const
+    {
+        Corpus const& corpus = *domCorpus_;
+        switch(key_)
+        {
+        case Key::Kind:
+            for(InfoKind kind : {
+                #define INFO_PASCAL(Type) InfoKind::Type,
+                #include <mrdocs/Metadata/InfoNodes.inc>
+                })
+            {
+                if(toString(kind) == key)
+                    return corpus.findByKind(kind);
+            }
+            return {};
+        case Key::Name:
+            return corpus.findByName(key);
+        case Key::File:
+            return corpus.findByFile(key);
+        default:
+            MRDOCS_UNREACHABLE();
+        }
+    }
+
+public:
+    DomIndexObject(
+        Key key,
+        DomCorpus const& domCorpus)
+        : key_(key)
+        , domCorpus_(domCorpus)
+    {
+        Corpus const& corpus = *domCorpus_;
+        switch(key_)
+        {
+        case Key::Kind:
+            for(InfoKind kind : {
+                #define INFO_PASCAL(Type) InfoKind::Type,
+                #include <mrdocs/Metadata/InfoNodes.inc>
+                })
+            {
+                if(! corpus.findByKind(kind).empty())
+                    kinds_.emplace_back(toString(kind));
+            }
+            break;
+        case Key::Name:
+            keys_ = corpus.indexedNames();
+            break;
+        case Key::File:
+            keys_ = corpus.indexedFiles();
+            break;
+        default:
+            MRDOCS_UNREACHABLE();
+        }
+    }
+
+    std::size_t size() const override
+    {
+        if(key_ == Key::Kind)
+            return kinds_.size();
+        return keys_.size();
+    }
+
+    dom::Value get(std::string_view key) const override
+    {
+        return dom::newArray<DomInfoArray>(
+            find(key), domCorpus_);
+    }
+
+    void set(dom::String, dom::Value) override
+    {
+        Error("Object is const").Throw();
+    }
+
+    bool visit(std::function<bool(dom::String, dom::Value)> fn) const override
+    {
+        if(key_ == Key::Kind)
+        {
+            for(dom::String const& key : kinds_)
+            {
+                if(! fn(key, get(key)))
+                    return false;
+            }
+            return true;
+        }
+        for(std::string_view key : keys_)
+        {
+            if(! fn(dom::String(key), get(key)))
+                return false;
+        }
+        return true;
+    }
+
+    bool exists(std::string_view key) const override
+    {
+        return ! find(key).empty();
+    }
+};
+
 //------------------------------------------------
 
 } // (anon)
@@ -929,6 +1095,10 @@ class DomCorpus::Impl
     Corpus const& corpus_;
     std::unordered_map<SymbolID, value_type> cache_;
     std::mutex mutex_;
+    std::once_flag indexesOnce_;
+    dom::Object byKind_;
+    dom::Object byName_;
+    dom::Object byFile_;
 
 public:
     Impl(
@@ -975,6 +1145,25 @@ public:
         it->second = obj.impl();
         return obj;
     }
+
+    dom::Object
+    getIndexes()
+    {
+        // The indexes are read-only, and shared by the
+        // objects returned to each context
+        std::call_once(indexesOnce_, [&]
+        {
+            using Key = DomIndexObject::Key;
+            byKind_ = dom::newObject<DomIndexObject>(Key::Kind, domCorpus_);
+            byName_ = dom::newObject<DomIndexObject>(Key::Name, domCorpus_);
+            byFile_ = dom::newObject<DomIndexObject>(Key::File, domCorpus_);
+        });
+        return dom::Object({
+            { "kind", byKind_ },
+            { "name", byName_ },
+            { "file", byFile_ }
+            });
+    }
 };
 
 DomCorpus::
@@ -1028,6 +1217,13 @@ get(SymbolID const& id) const
     return impl_->get(id);
 }
 
+dom::Object
+DomCorpus::
+getIndexes() const
+{
+    return impl_->getIndexes();
+}
+
 dom::Value
 DomCorpus::
 getJavadoc(
@@ -10,15 +10,100 @@
 
 #include "Finalize.hpp"
 #include "lib/Lib/Info.hpp"
+#include "lib/Metadata/Overloads.hpp"
 #include "lib/Support/NameParser.hpp"
+#include "lib/Support/Stats.hpp"
 #include <mrdocs/Metadata.hpp>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <ranges>
 #include <span>
+#include <string>
+#include <unordered_map>
 
 namespace clang {
 namespace mrdocs {
 
+namespace {
+
+/** Memoizes the resolution of documentation references.
+
+    Unless the documentation of the referenced symbol
+    is copied, the result of resolving a reference only
+    depends on its string and on the symbol where
+    unqualified lookup starts, which is shared by all
+    the members of a scope.
+*/
+class ReferenceCache
+{
+    static constexpr std::size_t shardCount = 64;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, SymbolID> results;
+    };
+
+    std::array<Shard, shardCount> shards_;
+    std::atomic<std::size_t> hits_ = 0;
+    std::atomic<std::size_t> misses_ = 0;
+
+    Shard&
+    shard(std::string_view key) noexcept
+    {
+        return shards_[std::hash<std::string_view>()(key) % shardCount];
+    }
+
+public:
+    /** Return the key of a reference from a lookup context.
+    */
+    static
+    std::string
+    makeKey(const Info* context, std::string_view ref)
+    {
+        std::string key(
+            reinterpret_cast<char const*>(&context), sizeof(context));
+        key.append(ref);
+        return key;
+    }
+
+    /** Return the cached result, or nothing.
+
+        The result is an invalid SymbolID when
+        the reference was not resolved.
+    */
+    std::optional<SymbolID>
+    find(std::string const& key)
+    {
+        Shard& s = shard(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.results.find(key);
+        if(it == s.results.end())
+        {
+            ++misses_;
+            return std::nullopt;
+        }
+        ++hits_;
+        return it->second;
+    }
+
+    void
+    insert(std::string key, SymbolID const& id)
+    {
+        Shard& s = shard(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.results.try_emplace(std::move(key), id);
+    }
+
+    std::size_t hits() const noexcept { return hits_; }
+    std::size_t misses() const noexcept { return misses_; }
+};
+
+} // (anon)
+
 /** Finalizes a set of Info.
 
     This removes any references to SymbolIDs
@@ -28,18 +113,69 @@ namespace mrdocs {
 */
 class Finalizer
 {
-    InfoSet& info_;
-    SymbolLookup& lookup_;
+public:
+    /** A pass over the symbols.
+
+        Documentation references are resolved before
+        any SymbolID is removed, so that each pass
+        only modifies the symbol being finalized and
+        only reads what no other task modifies.
+    */
+    enum class Pass
+    {
+        // resolve the references of the documentation
+        References,
+        // remove the SymbolIDs which do not exist
+        Symbols
+    };
+
+private:
+    InfoSet const& info_;
+    SymbolLookup const& lookup_;
+    ReferenceCache& cache_;
+    Pass pass_;
     Info* current_ = nullptr;
 
     bool resolveReference(doc::Reference& ref)
+    {
+        std::string key;
+        if(ref.kind != doc::Kind::copied)
+        {
+            key = ReferenceCache::makeKey(
+                lookup_.adjustLookupContext(current_), ref.string);
+            if(auto id = cache_.find(key))
+            {
+                if(*id)
+                    ref.id = *id;
+                return static_cast<bool>(*id);
+            }
+        }
+
+        const Info* found = lookupReference(ref);
+        if(! key.empty())
+            cache_.insert(std::move(key),
+                found ? found->id : SymbolID::invalid);
+
+        // prevent recursive documentation copies
+        if(ref.kind == doc::Kind::copied &&
+            found && found->id == current_->id)
+            return false;
+
+        // if we found a symbol, replace the reference
+        // ID with the SymbolID of that symbol
+        if(found)
+            ref.id = found->id;
+        return found;
+    }
+
+    const Info* lookupReference(doc::Reference const& ref)
     {
         auto parse_result = parseIdExpression(ref.string);
         if(! parse_result)
-            return false;
+            return nullptr;
 
         if(parse_result->name.empty())
-            return false;
+            return nullptr;
 
         auto is_acceptable = [&](const Info& I) -> bool
         {
@@ -54,7 +190,7 @@ class Finalizer
         const Info* found = nullptr;
         if(parse_result->qualified)
         {
-            Info* context = current_;
+            Info const* context = current_;
             std::vector<std::string_view> qualifier;
             // KRYSTIAN FIXME: lookupQualified should accept
             // std::vector<std::string> as the qualifier
@@ -78,27 +214,21 @@ class Finalizer
                 parse_result->name,
                 is_acceptable);
         }
-
-        // prevent recursive documentation copies
-        if(ref.kind == doc::Kind::copied &&
-            found && found->id == current_->id)
-            return false;
-
-        // if we found a symbol, replace the reference
-        // ID with the SymbolID of that symbol
-        if(found)
-            ref.id = found->id;
         return found;
     }
 
     void finalize(SymbolID& id)
     {
+        if(pass_ != Pass::Symbols)
+            return;
         if(id && ! info_.contains(id))
             id = SymbolID::invalid;
     }
 
     void finalize(std::vector<SymbolID>& ids)
     {
+        if(pass_ != Pass::Symbols)
+            return;
         std::erase_if(ids, [this](const SymbolID& id)
         {
             return ! id || ! info_.contains(id);
@@ -190,6 +320,8 @@ class Finalizer
 
             if constexpr(std::derived_from<NodeTy, doc::Reference>)
             {
+                if(pass_ != Pass::References)
+                    return;
 #if 0
                 // This warning shouldn't be triggered if the symbol has
                 // been explicitly marked excluded in mrdocs.yml
@@ -244,6 +376,20 @@ class Finalizer
             finalize(elem);
     }
 
+    void groupOverloads(ScopeInfo& S)
+    {
+        if(pass_ != Pass::Symbols)
+            return;
+        mrdocs::groupOverloads(S,
+            [this](const SymbolID& id) -> const Info*
+            {
+                auto it = info_.find(id);
+                if(it == info_.end())
+                    return nullptr;
+                return it->get();
+            });
+    }
+
     // ----------------------------------------------------------------
 
     void check(const SymbolID& id)
@@ -263,10 +409,14 @@ class Finalizer
 
 public:
     Finalizer(
-        InfoSet& Info,
-        SymbolLookup& Lookup)
+        InfoSet const& Info,
+        SymbolLookup const& Lookup,
+        ReferenceCache& cache,
+        Pass pass)
         : info_(Info)
         , lookup_(Lookup)
+        , cache_(cache)
+        , pass_(pass)
     {
     }
 
@@ -280,6 +430,7 @@ public:
     {
         check(I.Namespace);
         check(I.Members);
+        groupOverloads(I);
         finalize(I.javadoc);
         finalize(I.UsingDirectives);
         // finalize(I.Specializations);
@@ -289,6 +440,7 @@ public:
     {
         check(I.Namespace);
         check(I.Members);
+        groupOverloads(I);
         finalize(I.javadoc);
         // finalize(I.Specializations);
         finalize(I.Template);
@@ -299,6 +451,7 @@ public:
     {
         check(I.Namespace);
         check(I.Members);
+        groupOverloads(I);
         finalize(I.javadoc);
         finalize(I.Primary);
         finalize(I.Args);
@@ -325,6 +478,7 @@ public:
     {
         check(I.Namespace);
         check(I.Members);
+        groupOverloads(I);
         finalize(I.javadoc);
         finalize(I.UnderlyingType);
     }
@@ -397,15 +551,54 @@ public:
 
     References which should always be valid are not checked.
 */
-void
-finalize(InfoSet& Info, SymbolLookup& Lookup)
+mrdocs::Expected<void>
+finalize(
+    InfoSet& Info,
+    SymbolLookup const& Lookup,
+    ThreadPool& threadPool)
 {
-    Finalizer visitor(Info, Lookup);
+    std::vector<mrdocs::Info*> infos;
+    infos.reserve(Info.size());
     for(auto& I : Info)
     {
         MRDOCS_ASSERT(I);
-        visitor.finalize(*I);
+        infos.push_back(I.get());
     }
+
+    // Each pass runs in chunks on the thread pool,
+    // and the second pass starts after the first
+    ReferenceCache cache;
+    constexpr std::size_t infosPerTask = 256;
+    for(auto pass : {
+        Finalizer::Pass::References,
+        Finalizer::Pass::Symbols })
+    {
+        TaskGroup taskGroup(threadPool);
+        for(std::size_t i = 0; i < infos.size(); i += infosPerTask)
+        {
+            taskGroup.async(
+            [&, pass, first = i]()
+            {
+                Finalizer visitor(Info, Lookup, cache, pass);
+                std::size_t const last = std::min(
+                    first + infosPerTask, infos.size());
+                for(std::size_t j = first; j < last; ++j)
+                    visitor.finalize(*infos[j]);
+            });
+        }
+        if(auto errors = taskGroup.wait(); ! errors.empty())
+            return Unexpected(formatError(
+                "Failed to finalize symbols: {}", Error(errors)));
+    }
+
+    report::debug(
+        "Finalize: {} of {} references cached, {} of {} lookup tables built",
+        cache.hits(), cache.hits() + cache.misses(),
+        Lookup.tablesBuilt(), Lookup.tableCount());
+    Stats::get().addCounter("reference-cache-hits", cache.hits());
+    Stats::get().addCounter("reference-cache-misses", cache.misses());
+    Stats::get().addCounter("lookup-tables-built", Lookup.tablesBuilt());
+    return {};
 }
 
 } // mrdocs
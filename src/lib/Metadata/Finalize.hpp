@@ -13,11 +13,26 @@
 
 #include "lib/Lib/Info.hpp"
 #include "lib/Lib/Lookup.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
 
 namespace clang {
 namespace mrdocs {
 
-void finalize(InfoSet& Info, SymbolLookup& Lookup);
+/** Finalizes a set of Info.
+
+    The symbols are finalized concurrently
+    on the thread pool, and the results do
+    not depend on the order of the symbols.
+
+    @return The errors thrown while finalizing,
+    if any.
+*/
+mrdocs::Expected<void>
+finalize(
+    InfoSet& Info,
+    SymbolLookup const& Lookup,
+    ThreadPool& threadPool);
 
 } // mrdocs
 } // clang
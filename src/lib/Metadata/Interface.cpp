@@ -10,6 +10,7 @@
 //
 
 #include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Metadata/Overloads.hpp"
 #include "lib/Support/Debug.hpp"
 #include <mrdocs/Metadata/Interface.hpp>
 #include <mrdocs/Support/TypeTraits.hpp>
@@ -326,6 +327,20 @@ buildTranches(
         if constexpr(InfoTy::isNamespace())
             builder.addFrom(II);
     });
+
+    // The overload sets of a tranche only
+    // contain the functions of its access
+    auto find = [&](SymbolID const& id)
+    {
+        return corpus.find(id);
+    };
+    for(Tranche* T : { None, Public, Protected, Private })
+    {
+        if(! T)
+            continue;
+        groupOverloads(T->Overloads, find);
+        groupOverloads(T->StaticOverloads, find);
+    }
 }
 
 } // (anon)
@@ -8,15 +8,57 @@
 // Official repository: https://github.com/cppalliance/mrdocs
 //
 
+#include "lib/Metadata/Overloads.hpp"
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata/Function.hpp>
 #include <mrdocs/Metadata/Namespace.hpp>
 #include <mrdocs/Metadata/Overloads.hpp>
 #include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/StringRef.h>
+#include <algorithm>
 
 namespace clang {
 namespace mrdocs {
 
+void
+groupOverloads(
+    ScopeInfo& S,
+    llvm::function_ref<Info const*(SymbolID const&)> find)
+{
+    S.OverloadGroups.clear();
+    S.OverloadMembers.clear();
+    S.OverloadGroups.reserve(S.Members.size());
+    for(SymbolID const& id : S.Members)
+    {
+        Info const* member = find(id);
+        MRDOCS_ASSERT(member);
+        auto const it = S.Lookups.find(member->Name);
+        if(it == S.Lookups.end() || it->second.size() == 1)
+        {
+            S.OverloadGroups.push_back({ id, 0, 0 });
+            continue;
+        }
+        auto const& lookup = it->second;
+        auto const first_func = std::ranges::find_if(lookup,
+            [&](SymbolID const& elem)
+            {
+                Info const* I = find(elem);
+                return I && I->isFunction();
+            });
+        if(first_func == lookup.end())
+        {
+            S.OverloadGroups.push_back({ id, 0, 0 });
+        }
+        else if(*first_func == id)
+        {
+            S.OverloadGroups.push_back({ id,
+                static_cast<std::uint32_t>(S.OverloadMembers.size()),
+                static_cast<std::uint32_t>(lookup.size()) });
+            S.OverloadMembers.insert(S.OverloadMembers.end(),
+                lookup.begin(), lookup.end());
+        }
+    }
+}
+
 } // mrdocs
 } // clang
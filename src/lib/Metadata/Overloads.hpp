@@ -0,0 +1,40 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_METADATA_OVERLOADS_HPP
+#define MRDOCS_LIB_METADATA_OVERLOADS_HPP
+
+#include <mrdocs/Metadata/Info.hpp>
+#include <mrdocs/Metadata/Scope.hpp>
+#include <llvm/ADT/STLFunctionalExtras.h>
+
+namespace clang {
+namespace mrdocs {
+
+/** Group the members of a scope into overload sets.
+
+    The groups are visited in the order of the
+    members. A member whose name is shared with a
+    function is visited as the overload set of the
+    name, at the first function with that name.
+
+    @param S The scope whose groups are computed.
+    @param find Return the symbol with the
+    specified ID, or nullptr.
+*/
+void
+groupOverloads(
+    ScopeInfo& S,
+    llvm::function_ref<Info const*(SymbolID const&)> find);
+
+} // mrdocs
+} // clang
+
+#endif
@@ -27,8 +27,8 @@ struct LocationEqual
         Location const& L1) const noexcept
     {
         return
-            std::tie(L0.LineNumber, L0.Filename) ==
-            std::tie(L1.LineNumber, L1.Filename);
+            std::tie(L0.LineNumber, L0.File) ==
+            std::tie(L1.LineNumber, L1.File);
     }
 };
 
@@ -38,13 +38,21 @@ struct LocationLess
     // No specific order (attributes more important than others) is required. Any
     // sort is enough, the order is only needed to call std::unique after sorting
     // the vector.
+    //
+    // The indices of the files depend on the order in which
+    // threads interned them, so the paths are compared instead
+    // to keep the order the same between runs.
     bool operator()(
         Location const& L0,
         Location const& L1) const noexcept
     {
+        if(L0.LineNumber != L1.LineNumber)
+            return L0.LineNumber < L1.LineNumber;
+        if(L0.File == L1.File)
+            return false;
         return
-            std::tie(L0.LineNumber, L0.Filename) <
-            std::tie(L1.LineNumber, L1.Filename);
+            std::make_tuple(L0.filename(), L0.path()) <
+            std::make_tuple(L1.filename(), L1.path());
     }
 };
 
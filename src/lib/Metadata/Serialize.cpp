@@ -0,0 +1,1159 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "Serialize.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <cstring>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+//------------------------------------------------
+//
+// Info fields
+//
+//------------------------------------------------
+
+void
+writeFields(BinaryWriter& w, NamespaceInfo const& I)
+{
+    w.write(static_cast<ScopeInfo const&>(I));
+    w.writeInteger(I.specs.raw.value);
+    w.write(I.UsingDirectives);
+}
+
+void
+writeFields(BinaryWriter& w, RecordInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(static_cast<ScopeInfo const&>(I));
+    w.writeEnum(I.KeyKind);
+    w.write(I.Template);
+    w.writeBool(I.IsTypeDef);
+    w.writeInteger(I.specs.raw.value);
+    w.write(I.Bases);
+}
+
+void
+writeFields(BinaryWriter& w, FunctionInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.ReturnType);
+    w.write(I.Params);
+    w.write(I.Template);
+    w.writeEnum(I.Class);
+    w.writeInteger(I.specs0.raw.value);
+    w.writeInteger(I.specs1.raw.value);
+    w.write(I.Noexcept);
+    w.write(I.Explicit);
+    w.write(I.Requires);
+}
+
+void
+writeFields(BinaryWriter& w, EnumInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(static_cast<ScopeInfo const&>(I));
+    w.writeBool(I.Scoped);
+    w.write(I.UnderlyingType);
+}
+
+void
+writeFields(BinaryWriter& w, TypedefInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.Type);
+    w.writeBool(I.IsUsing);
+    w.write(I.Template);
+}
+
+void
+writeFields(BinaryWriter& w, VariableInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.Type);
+    w.write(I.Template);
+    w.writeInteger(I.specs.raw.value);
+    w.write(I.Initializer);
+}
+
+void
+writeFields(BinaryWriter& w, FieldInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.Type);
+    w.write(I.Default);
+    w.writeInteger(I.specs.raw.value);
+    w.writeBool(I.IsMutable);
+    w.writeBool(I.IsBitfield);
+    w.write(I.BitfieldWidth);
+}
+
+void
+writeFields(BinaryWriter& w, SpecializationInfo const& I)
+{
+    w.write(static_cast<ScopeInfo const&>(I));
+    w.write(I.Args);
+    w.writeSymbolID(I.Primary);
+}
+
+void
+writeFields(BinaryWriter& w, FriendInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.writeSymbolID(I.FriendSymbol);
+    w.write(I.FriendType);
+}
+
+void
+writeFields(BinaryWriter& w, EnumeratorInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.Initializer);
+}
+
+void
+writeFields(BinaryWriter& w, GuideInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.Deduced);
+    w.write(I.Template);
+    w.write(I.Params);
+    w.write(I.Explicit);
+}
+
+void
+writeFields(BinaryWriter& w, AliasInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.AliasedSymbol);
+}
+
+void
+writeFields(BinaryWriter& w, UsingInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.writeEnum(I.Class);
+    w.write(I.UsingSymbols);
+    w.write(I.Qualifier);
+}
+
+void
+writeFields(BinaryWriter& w, ConceptInfo const& I)
+{
+    w.write(static_cast<SourceInfo const&>(I));
+    w.write(I.Template);
+    w.write(I.Constraint);
+}
+
+void
+readFields(BinaryReader& r, NamespaceInfo& I)
+{
+    r.read(static_cast<ScopeInfo&>(I));
+    I.specs.raw.value = r.readInteger();
+    r.read(I.UsingDirectives);
+}
+
+void
+readFields(BinaryReader& r, RecordInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(static_cast<ScopeInfo&>(I));
+    I.KeyKind = r.readEnum<RecordKeyKind>();
+    r.read(I.Template);
+    I.IsTypeDef = r.readBool();
+    I.specs.raw.value = r.readInteger();
+    r.read(I.Bases);
+}
+
+void
+readFields(BinaryReader& r, FunctionInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.ReturnType);
+    r.read(I.Params);
+    r.read(I.Template);
+    I.Class = r.readEnum<FunctionClass>();
+    I.specs0.raw.value = r.readInteger();
+    I.specs1.raw.value = r.readInteger();
+    r.read(I.Noexcept);
+    r.read(I.Explicit);
+    r.read(I.Requires);
+}
+
+void
+readFields(BinaryReader& r, EnumInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(static_cast<ScopeInfo&>(I));
+    I.Scoped = r.readBool();
+    r.read(I.UnderlyingType);
+}
+
+void
+readFields(BinaryReader& r, TypedefInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.Type);
+    I.IsUsing = r.readBool();
+    r.read(I.Template);
+}
+
+void
+readFields(BinaryReader& r, VariableInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.Type);
+    r.read(I.Template);
+    I.specs.raw.value = r.readInteger();
+    r.read(I.Initializer);
+}
+
+void
+readFields(BinaryReader& r, FieldInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.Type);
+    r.read(I.Default);
+    I.specs.raw.value = r.readInteger();
+    I.IsMutable = r.readBool();
+    I.IsBitfield = r.readBool();
+    r.read(I.BitfieldWidth);
+}
+
+void
+readFields(BinaryReader& r, SpecializationInfo& I)
+{
+    r.read(static_cast<ScopeInfo&>(I));
+    r.read(I.Args);
+    I.Primary = r.readSymbolID();
+}
+
+void
+readFields(BinaryReader& r, FriendInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    I.FriendSymbol = r.readSymbolID();
+    r.read(I.FriendType);
+}
+
+void
+readFields(BinaryReader& r, EnumeratorInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.Initializer);
+}
+
+void
+readFields(BinaryReader& r, GuideInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.Deduced);
+    r.read(I.Template);
+    r.read(I.Params);
+    r.read(I.Explicit);
+}
+
+void
+readFields(BinaryReader& r, AliasInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.AliasedSymbol);
+}
+
+void
+readFields(BinaryReader& r, UsingInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    I.Class = r.readEnum<UsingClass>();
+    r.read(I.UsingSymbols);
+    r.read(I.Qualifier);
+}
+
+void
+readFields(BinaryReader& r, ConceptInfo& I)
+{
+    r.read(static_cast<SourceInfo&>(I));
+    r.read(I.Template);
+    r.read(I.Constraint);
+}
+
+} // (anon)
+
+//------------------------------------------------
+//
+// BinaryWriter
+//
+//------------------------------------------------
+
+void
+BinaryWriter::
+writeHeader(std::string_view magic)
+{
+    MRDOCS_ASSERT(magic.size() == 4);
+    out_.append(magic);
+    writeInteger(binaryFormatVersion);
+}
+
+void
+BinaryWriter::
+writeInteger(std::uint64_t value)
+{
+    do
+    {
+        unsigned char byte = value & 0x7f;
+        value >>= 7;
+        if(value != 0)
+            byte |= 0x80;
+        out_.push_back(static_cast<char>(byte));
+    }
+    while(value != 0);
+}
+
+void
+BinaryWriter::
+writeBool(bool value)
+{
+    out_.push_back(value ? 1 : 0);
+}
+
+void
+BinaryWriter::
+writeString(std::string_view s)
+{
+    writeInteger(s.size());
+    out_.append(s);
+}
+
+void
+BinaryWriter::
+writeSymbolID(SymbolID const& id)
+{
+    out_.append(std::string_view(id));
+}
+
+void
+BinaryWriter::
+writeInfo(Info const& I)
+{
+    writeEnum(I.Kind);
+    writeSymbolID(I.id);
+    writeString(I.Name);
+    writeEnum(I.Access);
+    writeBool(I.Implicit);
+    write(I.Namespace);
+    write(I.javadoc);
+    visit(I, [&]<class InfoTy>(InfoTy const& U)
+    {
+        writeFields(*this, U);
+    });
+}
+
+void
+BinaryWriter::
+writeInfoSet(InfoSet const& info)
+{
+    writeInteger(info.size());
+    std::string record;
+    for(auto const& I : info)
+    {
+        record.clear();
+        BinaryWriter(record).writeInfo(*I);
+        writeString(record);
+    }
+}
+
+void
+BinaryWriter::
+write(Location const& loc)
+{
+    // Files are written by name, since the
+    // indices of the file table are not stable
+    writeString(loc.path());
+    writeString(loc.filename());
+    writeInteger(loc.LineNumber);
+    writeEnum(loc.Kind);
+    writeBool(loc.Documented);
+}
+
+void
+BinaryWriter::
+write(SourceInfo const& I)
+{
+    writeBool(I.DefLoc.has_value());
+    if(I.DefLoc)
+        write(*I.DefLoc);
+    write(I.Loc);
+}
+
+void
+BinaryWriter::
+write(ScopeInfo const& I)
+{
+    write(I.Members);
+    writeInteger(I.Lookups.size());
+    for(auto const& [name, ids] : I.Lookups)
+    {
+        writeString(name);
+        write(ids);
+    }
+    writeInteger(I.OverloadGroups.size());
+    for(auto const& group : I.OverloadGroups)
+    {
+        writeSymbolID(group.Member);
+        writeInteger(group.First);
+        writeInteger(group.Count);
+    }
+    write(I.OverloadMembers);
+}
+
+void
+BinaryWriter::
+write(TypeInfo const& I)
+{
+    writeEnum(I.Kind);
+    writeBool(I.IsPackExpansion);
+    visit(I, [&]<class TypeTy>(TypeTy const& T)
+    {
+        if constexpr(requires { T.CVQualifiers; })
+            writeEnum(T.CVQualifiers);
+        if constexpr(TypeTy::isNamed())
+        {
+            write(T.Name);
+        }
+        if constexpr(TypeTy::isDecltype())
+        {
+            write(T.Operand);
+        }
+        if constexpr(TypeTy::isAuto())
+        {
+            writeEnum(T.Keyword);
+            write(T.Constraint);
+        }
+        if constexpr(
+            TypeTy::isLValueReference() ||
+            TypeTy::isRValueReference() ||
+            TypeTy::isPointer())
+        {
+            write(T.PointeeType);
+        }
+        if constexpr(TypeTy::isMemberPointer())
+        {
+            write(T.ParentType);
+            write(T.PointeeType);
+        }
+        if constexpr(TypeTy::isArray())
+        {
+            write(T.ElementType);
+            write(T.Bounds);
+        }
+        if constexpr(TypeTy::isFunction())
+        {
+            write(T.ReturnType);
+            write(T.ParamTypes);
+            writeEnum(T.RefQualifier);
+            write(T.ExceptionSpec);
+            writeBool(T.IsVariadic);
+        }
+    });
+}
+
+void
+BinaryWriter::
+write(NameInfo const& I)
+{
+    writeEnum(I.Kind);
+    writeSymbolID(I.id);
+    writeString(I.Name);
+    write(I.Prefix);
+    if(I.isSpecialization())
+        write(static_cast<SpecializationNameInfo const&>(I).TemplateArgs);
+}
+
+void
+BinaryWriter::
+write(TArg const& I)
+{
+    writeEnum(I.Kind);
+    writeBool(I.IsPackExpansion);
+    visit(I, [&]<class TArgTy>(TArgTy const& A)
+    {
+        if constexpr(TArgTy::isType())
+        {
+            write(A.Type);
+        }
+        if constexpr(TArgTy::isNonType())
+        {
+            write(A.Value);
+        }
+        if constexpr(TArgTy::isTemplate())
+        {
+            writeSymbolID(A.Template);
+            writeString(A.Name);
+        }
+    });
+}
+
+void
+BinaryWriter::
+write(TParam const& I)
+{
+    writeEnum(I.Kind);
+    writeString(I.Name);
+    writeBool(I.IsParameterPack);
+    write(I.Default);
+    visit(I, [&]<class TParamTy>(TParamTy const& P)
+    {
+        if constexpr(TParamTy::isType())
+        {
+            writeEnum(P.KeyKind);
+            write(P.Constraint);
+        }
+        if constexpr(TParamTy::isNonType())
+        {
+            write(P.Type);
+        }
+        if constexpr(TParamTy::isTemplate())
+        {
+            write(P.Params);
+        }
+    });
+}
+
+void
+BinaryWriter::
+write(TemplateInfo const& I)
+{
+    write(I.Params);
+    write(I.Args);
+    write(I.Requires);
+    writeSymbolID(I.Primary);
+}
+
+void
+BinaryWriter::
+write(ExprInfo const& I)
+{
+    writeString(I.Written);
+}
+
+void
+BinaryWriter::
+write(NoexceptInfo const& I)
+{
+    writeBool(I.Implicit);
+    writeEnum(I.Kind);
+    writeString(I.Operand);
+}
+
+void
+BinaryWriter::
+write(ExplicitInfo const& I)
+{
+    writeBool(I.Implicit);
+    writeEnum(I.Kind);
+    writeString(I.Operand);
+}
+
+void
+BinaryWriter::
+write(Param const& I)
+{
+    write(I.Type);
+    writeString(I.Name);
+    writeString(I.Default);
+}
+
+void
+BinaryWriter::
+write(BaseInfo const& I)
+{
+    write(I.Type);
+    writeEnum(I.Access);
+    writeBool(I.IsVirtual);
+}
+
+void
+BinaryWriter::
+write(Javadoc const& I)
+{
+    write(I.getBlocks());
+}
+
+void
+BinaryWriter::
+write(doc::Node const& I)
+{
+    writeEnum(I.kind);
+    doc::visit(I, [&]<class NodeTy>(NodeTy const& N)
+    {
+        if constexpr(std::derived_from<NodeTy, doc::Text>)
+        {
+            writeString(N.string);
+            if constexpr(std::same_as<NodeTy, doc::Styled>)
+                writeEnum(N.style);
+            if constexpr(std::same_as<NodeTy, doc::Link>)
+                writeString(N.href);
+            if constexpr(std::derived_from<NodeTy, doc::Reference>)
+                writeSymbolID(N.id);
+            if constexpr(std::same_as<NodeTy, doc::Copied>)
+                writeEnum(N.parts);
+        }
+        else
+        {
+            if constexpr(std::same_as<NodeTy, doc::Heading>)
+                writeString(N.string);
+            if constexpr(std::same_as<NodeTy, doc::Admonition>)
+                writeEnum(N.admonish);
+            if constexpr(std::same_as<NodeTy, doc::Param>)
+            {
+                writeString(N.name);
+                writeEnum(N.direction);
+            }
+            if constexpr(std::same_as<NodeTy, doc::TParam>)
+                writeString(N.name);
+            if constexpr(std::same_as<NodeTy, doc::Throws>)
+                writeString(N.exception);
+            write(N.children);
+        }
+    });
+}
+
+//------------------------------------------------
+//
+// BinaryReader
+//
+//------------------------------------------------
+
+void
+BinaryReader::
+readHeader(std::string_view magic)
+{
+    MRDOCS_ASSERT(magic.size() == 4);
+    if(readBytes(magic.size()) != magic)
+        formatError("not a MrDocs binary file").Throw();
+    if(auto version = readInteger();
+        version != binaryFormatVersion)
+    {
+        formatError(
+            "unsupported binary format version {} (expected {})",
+            version, binaryFormatVersion).Throw();
+    }
+}
+
+std::uint64_t
+BinaryReader::
+readInteger()
+{
+    std::uint64_t value = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if(in_.empty())
+            formatError("unexpected end of binary data").Throw();
+        auto const byte = static_cast<unsigned char>(in_.front());
+        in_.remove_prefix(1);
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if(! (byte & 0x80))
+            return value;
+    }
+    formatError("malformed integer in binary data").Throw();
+}
+
+bool
+BinaryReader::
+readBool()
+{
+    return readBytes(1).front() != 0;
+}
+
+std::string
+BinaryReader::
+readString()
+{
+    return std::string(readBytes(readInteger()));
+}
+
+std::string_view
+BinaryReader::
+readBytes(std::size_t n)
+{
+    if(n > in_.size())
+        formatError("unexpected end of binary data").Throw();
+    std::string_view s = in_.substr(0, n);
+    in_.remove_prefix(n);
+    return s;
+}
+
+SymbolID
+BinaryReader::
+readSymbolID()
+{
+    return SymbolID(readBytes(20).data());
+}
+
+std::unique_ptr<Info>
+BinaryReader::
+readInfo()
+{
+    auto const kind = readEnum<InfoKind>();
+    SymbolID const id = readSymbolID();
+    std::unique_ptr<Info> I;
+    switch(kind)
+    {
+    #define INFO_PASCAL(Type) \
+    case InfoKind::Type: \
+        I = std::make_unique<Type##Info>(id); \
+        break;
+    #include <mrdocs/Metadata/InfoNodes.inc>
+    default:
+        formatError("invalid symbol kind {} in binary data",
+            static_cast<int>(kind)).Throw();
+    }
+    I->Name = readString();
+    I->Access = readEnum<AccessKind>();
+    I->Implicit = readBool();
+    read(I->Namespace);
+    read(I->javadoc);
+    visit(*I, [&]<class InfoTy>(InfoTy& U)
+    {
+        readFields(*this, U);
+    });
+    return I;
+}
+
+InfoSet
+BinaryReader::
+readInfoSet()
+{
+    InfoSet info;
+    auto n = readInteger();
+    info.reserve(std::min<std::uint64_t>(n, in_.size()));
+    while(n--)
+    {
+        BinaryReader record(readBytes(readInteger()));
+        info.emplace(record.readInfo());
+    }
+    return info;
+}
+
+void
+BinaryReader::
+read(Location& loc)
+{
+    std::string path = readString();
+    std::string filename = readString();
+    loc.File = FileTable::intern(path, filename);
+    loc.LineNumber = static_cast<unsigned>(readInteger());
+    loc.Kind = readEnum<FileKind>();
+    loc.Documented = readBool();
+}
+
+void
+BinaryReader::
+read(SourceInfo& I)
+{
+    if(readBool())
+        read(I.DefLoc.emplace());
+    read(I.Loc);
+}
+
+void
+BinaryReader::
+read(ScopeInfo& I)
+{
+    read(I.Members);
+    auto n = readInteger();
+    I.Lookups.clear();
+    while(n--)
+    {
+        std::string name = readString();
+        read(I.Lookups[std::move(name)]);
+    }
+    n = readInteger();
+    I.OverloadGroups.clear();
+    I.OverloadGroups.reserve(std::min<std::uint64_t>(n, in_.size()));
+    while(n--)
+    {
+        OverloadGroup& group = I.OverloadGroups.emplace_back();
+        group.Member = readSymbolID();
+        group.First = static_cast<std::uint32_t>(readInteger());
+        group.Count = static_cast<std::uint32_t>(readInteger());
+    }
+    read(I.OverloadMembers);
+}
+
+void
+BinaryReader::
+read(std::unique_ptr<TypeInfo>& p)
+{
+    p.reset();
+    if(! readBool())
+        return;
+    auto const kind = readEnum<TypeKind>();
+    switch(kind)
+    {
+    case TypeKind::Named:
+        p = std::make_unique<NamedTypeInfo>(); break;
+    case TypeKind::Decltype:
+        p = std::make_unique<DecltypeTypeInfo>(); break;
+    case TypeKind::Auto:
+        p = std::make_unique<AutoTypeInfo>(); break;
+    case TypeKind::LValueReference:
+        p = std::make_unique<LValueReferenceTypeInfo>(); break;
+    case TypeKind::RValueReference:
+        p = std::make_unique<RValueReferenceTypeInfo>(); break;
+    case TypeKind::Pointer:
+        p = std::make_unique<PointerTypeInfo>(); break;
+    case TypeKind::MemberPointer:
+        p = std::make_unique<MemberPointerTypeInfo>(); break;
+    case TypeKind::Array:
+        p = std::make_unique<ArrayTypeInfo>(); break;
+    case TypeKind::Function:
+        p = std::make_unique<FunctionTypeInfo>(); break;
+    default:
+        formatError("invalid type kind {} in binary data",
+            static_cast<int>(kind)).Throw();
+    }
+    p->IsPackExpansion = readBool();
+    visit(*p, [&]<class TypeTy>(TypeTy& T)
+    {
+        if constexpr(requires { T.CVQualifiers; })
+            T.CVQualifiers = readEnum<QualifierKind>();
+        if constexpr(TypeTy::isNamed())
+        {
+            read(T.Name);
+        }
+        if constexpr(TypeTy::isDecltype())
+        {
+            read(T.Operand);
+        }
+        if constexpr(TypeTy::isAuto())
+        {
+            T.Keyword = readEnum<AutoKind>();
+            read(T.Constraint);
+        }
+        if constexpr(
+            TypeTy::isLValueReference() ||
+            TypeTy::isRValueReference() ||
+            TypeTy::isPointer())
+        {
+            read(T.PointeeType);
+        }
+        if constexpr(TypeTy::isMemberPointer())
+        {
+            read(T.ParentType);
+            read(T.PointeeType);
+        }
+        if constexpr(TypeTy::isArray())
+        {
+            read(T.ElementType);
+            read(T.Bounds);
+        }
+        if constexpr(TypeTy::isFunction())
+        {
+            read(T.ReturnType);
+            read(T.ParamTypes);
+            T.RefQualifier = readEnum<ReferenceKind>();
+            read(T.ExceptionSpec);
+            T.IsVariadic = readBool();
+        }
+    });
+}
+
+void
+BinaryReader::
+read(std::unique_ptr<NameInfo>& p)
+{
+    p.reset();
+    if(! readBool())
+        return;
+    auto const kind = readEnum<NameKind>();
+    switch(kind)
+    {
+    case NameKind::Identifier:
+        p = std::make_unique<NameInfo>(); break;
+    case NameKind::Specialization:
+        p = std::make_unique<SpecializationNameInfo>(); break;
+    default:
+        formatError("invalid name kind {} in binary data",
+            static_cast<int>(kind)).Throw();
+    }
+    p->id = readSymbolID();
+    p->Name = readString();
+    read(p->Prefix);
+    if(p->isSpecialization())
+        read(static_cast<SpecializationNameInfo&>(*p).TemplateArgs);
+}
+
+void
+BinaryReader::
+read(std::unique_ptr<TArg>& p)
+{
+    p.reset();
+    if(! readBool())
+        return;
+    auto const kind = readEnum<TArgKind>();
+    switch(kind)
+    {
+    case TArgKind::Type:
+        p = std::make_unique<TypeTArg>(); break;
+    case TArgKind::NonType:
+        p = std::make_unique<NonTypeTArg>(); break;
+    case TArgKind::Template:
+        p = std::make_unique<TemplateTArg>(); break;
+    default:
+        formatError("invalid template argument kind {} in binary data",
+            static_cast<int>(kind)).Throw();
+    }
+    p->IsPackExpansion = readBool();
+    visit(*p, [&]<class TArgTy>(TArgTy& A)
+    {
+        if constexpr(TArgTy::isType())
+        {
+            read(A.Type);
+        }
+        if constexpr(TArgTy::isNonType())
+        {
+            read(A.Value);
+        }
+        if constexpr(TArgTy::isTemplate())
+        {
+            A.Template = readSymbolID();
+            A.Name = readString();
+        }
+    });
+}
+
+void
+BinaryReader::
+read(std::unique_ptr<TParam>& p)
+{
+    p.reset();
+    if(! readBool())
+        return;
+    auto const kind = readEnum<TParamKind>();
+    switch(kind)
+    {
+    case TParamKind::Type:
+        p = std::make_unique<TypeTParam>(); break;
+    case TParamKind::NonType:
+        p = std::make_unique<NonTypeTParam>(); break;
+    case TParamKind::Template:
+        p = std::make_unique<TemplateTParam>(); break;
+    default:
+        formatError("invalid template parameter kind {} in binary data",
+            static_cast<int>(kind)).Throw();
+    }
+    p->Name = readString();
+    p->IsParameterPack = readBool();
+    read(p->Default);
+    visit(*p, [&]<class TParamTy>(TParamTy& P)
+    {
+        if constexpr(TParamTy::isType())
+        {
+            P.KeyKind = readEnum<TParamKeyKind>();
+            read(P.Constraint);
+        }
+        if constexpr(TParamTy::isNonType())
+        {
+            read(P.Type);
+        }
+        if constexpr(TParamTy::isTemplate())
+        {
+            read(P.Params);
+        }
+    });
+}
+
+void
+BinaryReader::
+read(std::unique_ptr<TemplateInfo>& p)
+{
+    p.reset();
+    if(! readBool())
+        return;
+    p = std::make_unique<TemplateInfo>();
+    read(*p);
+}
+
+void
+BinaryReader::
+read(std::unique_ptr<Javadoc>& p)
+{
+    p.reset();
+    if(! readBool())
+        return;
+    p = std::make_unique<Javadoc>();
+    read(*p);
+}
+
+void
+BinaryReader::
+read(TemplateInfo& I)
+{
+    read(I.Params);
+    read(I.Args);
+    read(I.Requires);
+    I.Primary = readSymbolID();
+}
+
+void
+BinaryReader::
+read(ExprInfo& I)
+{
+    I.Written = readString();
+}
+
+void
+BinaryReader::
+read(NoexceptInfo& I)
+{
+    I.Implicit = readBool();
+    I.Kind = readEnum<NoexceptKind>();
+    I.Operand = readString();
+}
+
+void
+BinaryReader::
+read(ExplicitInfo& I)
+{
+    I.Implicit = readBool();
+    I.Kind = readEnum<ExplicitKind>();
+    I.Operand = readString();
+}
+
+void
+BinaryReader::
+read(Param& I)
+{
+    read(I.Type);
+    I.Name = readString();
+    I.Default = readString();
+}
+
+void
+BinaryReader::
+read(BaseInfo& I)
+{
+    read(I.Type);
+    I.Access = readEnum<AccessKind>();
+    I.IsVirtual = readBool();
+}
+
+void
+BinaryReader::
+read(Javadoc& I)
+{
+    auto& blocks = I.getBlocks();
+    blocks.clear();
+    auto n = readInteger();
+    while(n--)
+    {
+        std::unique_ptr<doc::Node> node = readNode();
+        if(! node || ! node->isBlock())
+            formatError("expected a javadoc block in binary data").Throw();
+        blocks.emplace_back(static_cast<doc::Block*>(node.release()));
+    }
+}
+
+std::unique_ptr<doc::Node>
+BinaryReader::
+readNode()
+{
+    // nullable pointer flag written by BinaryWriter::write(unique_ptr)
+    if(! readBool())
+        return nullptr;
+    auto const kind = readEnum<doc::Kind>();
+    return doc::visit(kind, [&]<class NodeTy>() ->
+        std::unique_ptr<doc::Node>
+    {
+        if constexpr(std::same_as<NodeTy, void>)
+        {
+            formatError("invalid javadoc node kind {} in binary data",
+                static_cast<int>(kind)).Throw();
+        }
+        else
+        {
+            auto N = std::make_unique<NodeTy>();
+            if constexpr(std::derived_from<NodeTy, doc::Text>)
+            {
+                N->string = readString();
+                if constexpr(std::same_as<NodeTy, doc::Styled>)
+                    N->style = readEnum<doc::Style>();
+                if constexpr(std::same_as<NodeTy, doc::Link>)
+                    N->href = readString();
+                if constexpr(std::derived_from<NodeTy, doc::Reference>)
+                    N->id = readSymbolID();
+                if constexpr(std::same_as<NodeTy, doc::Copied>)
+                    N->parts = readEnum<doc::Parts>();
+            }
+            else
+            {
+                if constexpr(std::same_as<NodeTy, doc::Heading>)
+                    N->string = readString();
+                if constexpr(std::same_as<NodeTy, doc::Admonition>)
+                    N->admonish = readEnum<doc::Admonish>();
+                if constexpr(std::same_as<NodeTy, doc::Param>)
+                {
+                    N->name = readString();
+                    N->direction = readEnum<doc::ParamDirection>();
+                }
+                if constexpr(std::same_as<NodeTy, doc::TParam>)
+                    N->name = readString();
+                if constexpr(std::same_as<NodeTy, doc::Throws>)
+                    N->exception = readString();
+                auto n = readInteger();
+                while(n--)
+                {
+                    std::unique_ptr<doc::Node> child = readNode();
+                    if(! child || child->isBlock())
+                        formatError("expected a javadoc text node "
+                            "in binary data").Throw();
+                    N->children.emplace_back(
+                        static_cast<doc::Text*>(child.release()));
+                }
+            }
+            return N;
+        }
+    });
+}
+
+//------------------------------------------------
+
+std::string
+serializeInfoSet(InfoSet const& info)
+{
+    std::string out;
+    BinaryWriter w(out);
+    w.writeHeader("MRDI");
+    w.writeInfoSet(info);
+    return out;
+}
+
+Expected<InfoSet>
+deserializeInfoSet(std::string_view data)
+{
+    try
+    {
+        BinaryReader r(data);
+        r.readHeader("MRDI");
+        return r.readInfoSet();
+    }
+    catch(Exception const& ex)
+    {
+        return Unexpected(ex.error());
+    }
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,280 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_METADATA_SERIALIZE_HPP
+#define MRDOCS_LIB_METADATA_SERIALIZE_HPP
+
+#include "lib/Lib/Info.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** The version of the binary metadata format.
+
+    This must be incremented whenever the layout
+    of any serialized type changes, so that stale
+    data written by an older build is rejected
+    instead of being misinterpreted.
+*/
+inline constexpr std::uint32_t binaryFormatVersion = 2;
+
+/** Writes metadata in a compact binary format.
+
+    Integers are written as unsigned LEB128,
+    strings are length-prefixed, and symbol IDs
+    are written as their raw 20 bytes. Every
+    polymorphic node is preceded by its kind
+    so it can be reconstructed by @ref BinaryReader.
+
+    The format has no alignment or endianness
+    requirements and is not meant to be read
+    by anything other than @ref BinaryReader.
+*/
+class BinaryWriter
+{
+    std::string& out_;
+
+public:
+    /** Constructor.
+
+        @param out The buffer the data is appended to.
+    */
+    explicit
+    BinaryWriter(std::string& out) noexcept
+        : out_(out)
+    {
+    }
+
+    /** Write a file header.
+
+        The header consists of the four character
+        `magic` and @ref binaryFormatVersion.
+    */
+    void writeHeader(std::string_view magic);
+
+    void writeInteger(std::uint64_t value);
+    void writeBool(bool value);
+    void writeString(std::string_view s);
+    void writeSymbolID(SymbolID const& id);
+
+    template<class Enum>
+    requires std::is_enum_v<Enum>
+    void
+    writeEnum(Enum value)
+    {
+        writeInteger(static_cast<std::uint64_t>(value));
+    }
+
+    /** Write a symbol and all of its children.
+    */
+    void writeInfo(Info const& I);
+
+    /** Write every symbol in a set.
+
+        Each symbol is written as a length-prefixed
+        record, so a reader can skip symbols
+        without decoding them.
+    */
+    void writeInfoSet(InfoSet const& info);
+
+    void write(Location const& loc);
+    void write(SourceInfo const& I);
+    void write(ScopeInfo const& I);
+    void write(TypeInfo const& I);
+    void write(NameInfo const& I);
+    void write(TArg const& I);
+    void write(TParam const& I);
+    void write(TemplateInfo const& I);
+    void write(ExprInfo const& I);
+    void write(NoexceptInfo const& I);
+    void write(ExplicitInfo const& I);
+    void write(Param const& I);
+    void write(BaseInfo const& I);
+    void write(Javadoc const& I);
+    void write(doc::Node const& I);
+
+    template<class T>
+    void
+    write(ConstantExprInfo<T> const& I)
+    {
+        write(static_cast<ExprInfo const&>(I));
+        writeBool(I.Value.has_value());
+        if(I.Value)
+            writeInteger(static_cast<std::uint64_t>(*I.Value));
+    }
+
+    template<class T>
+    void
+    write(std::unique_ptr<T> const& p)
+    {
+        writeBool(p != nullptr);
+        if(p)
+            write(*p);
+    }
+
+    template<class T>
+    void
+    write(std::vector<T> const& v)
+    {
+        writeInteger(v.size());
+        for(auto const& elem : v)
+        {
+            if constexpr(std::same_as<T, SymbolID>)
+                writeSymbolID(elem);
+            else
+                write(elem);
+        }
+    }
+};
+
+/** Reads metadata written by @ref BinaryWriter.
+
+    Malformed or truncated input causes an
+    @ref Exception to be thrown; callers which
+    need an @ref Expected should use
+    @ref deserializeInfoSet.
+*/
+class BinaryReader
+{
+    std::string_view in_;
+
+public:
+    /** Constructor.
+
+        @param in The data to read. The
+        referenced buffer must outlive the reader.
+    */
+    explicit
+    BinaryReader(std::string_view in) noexcept
+        : in_(in)
+    {
+    }
+
+    /** Return true if there is no more data to read.
+    */
+    bool
+    empty() const noexcept
+    {
+        return in_.empty();
+    }
+
+    /** Return the data which has not yet been read.
+    */
+    std::string_view
+    remaining() const noexcept
+    {
+        return in_;
+    }
+
+    /** Read and validate a file header.
+
+        An exception is thrown if the magic
+        does not match or if the data was written
+        with a different @ref binaryFormatVersion.
+    */
+    void readHeader(std::string_view magic);
+
+    std::uint64_t readInteger();
+    bool readBool();
+    std::string readString();
+    std::string_view readBytes(std::size_t n);
+    SymbolID readSymbolID();
+
+    template<class Enum>
+    requires std::is_enum_v<Enum>
+    Enum
+    readEnum()
+    {
+        return static_cast<Enum>(readInteger());
+    }
+
+    std::unique_ptr<Info> readInfo();
+    InfoSet readInfoSet();
+
+    void read(Location& loc);
+    void read(SourceInfo& I);
+    void read(ScopeInfo& I);
+    void read(TemplateInfo& I);
+    void read(ExprInfo& I);
+    void read(NoexceptInfo& I);
+    void read(ExplicitInfo& I);
+    void read(Param& I);
+    void read(BaseInfo& I);
+    void read(Javadoc& I);
+
+    void read(std::unique_ptr<TypeInfo>& p);
+    void read(std::unique_ptr<NameInfo>& p);
+    void read(std::unique_ptr<TArg>& p);
+    void read(std::unique_ptr<TParam>& p);
+    void read(std::unique_ptr<TemplateInfo>& p);
+    void read(std::unique_ptr<Javadoc>& p);
+
+    template<class T>
+    void
+    read(ConstantExprInfo<T>& I)
+    {
+        read(static_cast<ExprInfo&>(I));
+        if(readBool())
+            I.Value = static_cast<T>(readInteger());
+    }
+
+    template<class T>
+    void
+    read(std::vector<T>& v)
+    {
+        auto const n = readInteger();
+        v.clear();
+        // every element takes at least one byte
+        v.reserve(std::min<std::uint64_t>(n, in_.size()));
+        for(std::uint64_t i = 0; i < n; ++i)
+        {
+            if constexpr(std::same_as<T, SymbolID>)
+                v.emplace_back(readSymbolID());
+            else
+                read(v.emplace_back());
+        }
+    }
+
+private:
+    std::unique_ptr<doc::Node> readNode();
+};
+
+/** Serialize a set of symbols.
+
+    @return The serialized bytes, including
+    a header identifying the format version.
+*/
+MRDOCS_DECL
+std::string
+serializeInfoSet(InfoSet const& info);
+
+/** Deserialize a set of symbols.
+
+    @param data The bytes previously returned
+    by @ref serializeInfoSet.
+*/
+MRDOCS_DECL
+Expected<InfoSet>
+deserializeInfoSet(std::string_view data);
+
+} // mrdocs
+} // clang
+
+#endif
@@ -10,6 +10,10 @@
 //
 
 #include <mrdocs/Metadata/Source.hpp>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace clang {
 namespace mrdocs {
@@ -30,5 +34,75 @@ toString(FileKind kind)
     };
 }
 
+namespace {
+
+struct FileTableImpl
+{
+    std::shared_mutex mutex;
+
+    // the entries never move once added
+    std::deque<FileTable::Entry> entries{ FileTable::Entry{} };
+
+    // the path and filename of each entry,
+    // separated by a null character
+    std::unordered_map<std::string, std::uint32_t> index;
+
+    static
+    FileTableImpl&
+    get() noexcept
+    {
+        static FileTableImpl impl;
+        return impl;
+    }
+};
+
+} // (anon)
+
+std::uint32_t
+FileTable::
+intern(
+    std::string_view path,
+    std::string_view filename)
+{
+    if (path.empty() && filename.empty())
+    {
+        return 0;
+    }
+    std::string key;
+    key.reserve(path.size() + filename.size() + 1);
+    key.append(path);
+    key.push_back('\0');
+    key.append(filename);
+
+    FileTableImpl& impl = FileTableImpl::get();
+    {
+        std::shared_lock<std::shared_mutex> lock(impl.mutex);
+        if (auto it = impl.index.find(key); it != impl.index.end())
+        {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(impl.mutex);
+    auto [it, inserted] = impl.index.try_emplace(
+        std::move(key), static_cast<std::uint32_t>(impl.entries.size()));
+    if (inserted)
+    {
+        impl.entries.push_back(Entry{
+            std::string(path), std::string(filename) });
+    }
+    return it->second;
+}
+
+auto
+FileTable::
+get(std::uint32_t index) noexcept ->
+    Entry const&
+{
+    FileTableImpl& impl = FileTableImpl::get();
+    std::shared_lock<std::shared_mutex> lock(impl.mutex);
+    MRDOCS_ASSERT(index < impl.entries.size());
+    return impl.entries[index];
+}
+
 } // mrdocs
 } // clang
@@ -10,9 +10,8 @@
 
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/ExecutorGroup.hpp>
-#include <mrdocs/Support/unlock_guard.hpp>
 #include <condition_variable>
-#include <unordered_set>
+#include <mutex>
 
 namespace clang {
 namespace mrdocs {
@@ -20,44 +19,16 @@ namespace mrdocs {
 struct ExecutorGroupBase::
     Impl
 {
-    ThreadPool& threadPool;
+    TaskGroup taskGroup;
+
+    // Protects agents_
     std::mutex mutex;
     std::condition_variable cv;
-    std::unordered_set<Error> errors;
-    std::size_t busy = 0;
 
     explicit
-    Impl(ThreadPool& threadPool_)
-        : threadPool(threadPool_)
-    {
-    }
-};
-
-class ExecutorGroupBase::
-    scoped_agent
-{
-    ExecutorGroupBase& group_;
-    std::unique_ptr<AnyAgent> agent_;
-
-public:
-    scoped_agent(
-        ExecutorGroupBase& group,
-        std::unique_ptr<AnyAgent> agent) noexcept
-        : group_(group)
-        , agent_(std::move(agent))
-    {
-    }
-
-    ~scoped_agent()
-    {
-        --group_.impl_->busy;
-        group_.agents_.emplace_back(std::move(agent_));
-        group_.impl_->cv.notify_all();
-    }
-
-    void* get() const noexcept
+    Impl(ThreadPool& threadPool)
+        : taskGroup(threadPool)
     {
-        return agent_->get();
     }
 };
 
@@ -81,74 +52,48 @@ ExecutorGroupBase(
 
 void
 ExecutorGroupBase::
-post(any_callable<void(void*)> work)
+post(
+    any_callable<void(void)> work,
+    TaskPriority priority)
 {
-    std::unique_lock<std::mutex> lock(impl_->mutex);
-    work_.emplace_back(std::move(work));
-    if(agents_.empty())
-        return;
-    run(std::move(lock));
+    impl_->taskGroup.async(priority, std::move(work));
 }
 
-void
+auto
 ExecutorGroupBase::
-run(std::unique_lock<std::mutex> lock)
+acquire() ->
+    std::unique_ptr<AnyAgent>
 {
+    // There is usually one agent per thread,
+    // so this only blocks when work from the
+    // group is run by a thread waiting on it
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    impl_->cv.wait(lock,
+        [&]
+        {
+            return ! agents_.empty();
+        });
     std::unique_ptr<AnyAgent> agent(std::move(agents_.back()));
     agents_.pop_back();
-    ++impl_->busy;
-    lock.unlock();
+    return agent;
+}
 
-    impl_->threadPool.async(
-    [this, agent = std::move(agent)]() mutable
+void
+ExecutorGroupBase::
+release(std::unique_ptr<AnyAgent> agent)
+{
     {
-        std::unique_lock<std::mutex> lock(impl_->mutex);
-        scoped_agent scope(*this, std::move(agent));
-        for(;;)
-        {
-            if(work_.empty())
-                break;
-            any_callable<void(void*)> work(
-                std::move(work_.front()));
-            work_.pop_front();
-            {
-                lock.unlock();
-                try
-                {
-                    work(scope.get());
-                    lock.lock();
-                }
-                catch(Exception const& ex)
-                {
-                    lock.lock();
-                    impl_->errors.emplace(ex.error());
-                }
-                catch(std::exception const& ex)
-                {
-                    lock.lock();
-                    impl_->errors.emplace(Error(ex));
-                }
-            }
-        }
-    });
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        agents_.emplace_back(std::move(agent));
+    }
+    impl_->cv.notify_one();
 }
 
 std::vector<Error>
 ExecutorGroupBase::
 wait() noexcept
 {
-    std::unique_lock<std::mutex> lock(impl_->mutex);
-    impl_->cv.wait(lock,
-        [&]
-        {
-            return work_.empty() && impl_->busy == 0;
-        });
-    std::vector<Error> errors;
-    errors.reserve(impl_->errors.size());
-    for(auto& err : impl_->errors)
-        errors.emplace_back(std::move(err));
-    impl_->errors.clear();
-    return errors;
+    return impl_->taskGroup.wait();
 }
 
 } // mrdocs
@@ -11,6 +11,7 @@
 
 #include "lib/AST/ParseJavadoc.hpp"
 #include "lib/Support/Path.hpp"
+#include "lib/Support/Stats.hpp"
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Generator.hpp>
 #include <llvm/ADT/SmallString.h>
@@ -80,7 +81,10 @@ buildOne(
 
     try
     {
-        return buildOne(os, corpus);
+        Error err = buildOne(os, corpus);
+        if(auto const n = os.tellp(); n > 0)
+            Stats::get().addBytesWritten(static_cast<std::uint64_t>(n));
+        return err;
     }
     catch(std::exception const& ex)
     {
@@ -9,43 +9,126 @@
 //
 
 #include "Glob.hpp"
+#include <algorithm>
 
 namespace clang {
 namespace mrdocs {
 
+namespace {
+
+/** Return true if the segment matches the start of a string.
+
+    The string must be at least as long as the segment.
+*/
 bool
-globMatch(
-    std::string_view pattern,
+matchesAt(
+    std::string_view segment,
     std::string_view str) noexcept
 {
-    if (pattern.empty())
+    for (std::size_t i = 0; i < segment.size(); ++i)
     {
-        return str.empty();
+        if (segment[i] != '?' && segment[i] != str[i])
+        {
+            return false;
+        }
     }
-    if (pattern[0] == '*')
+    return true;
+}
+
+/** Return the position of the first match of a segment.
+*/
+std::size_t
+findSegment(
+    std::string_view segment,
+    std::string_view str) noexcept
+{
+    if (segment.find('?') == std::string_view::npos)
+    {
+        return str.find(segment);
+    }
+    if (str.size() < segment.size())
+    {
+        return std::string_view::npos;
+    }
+    for (std::size_t i = 0; i <= str.size() - segment.size(); ++i)
+    {
+        if (matchesAt(segment, str.substr(i)))
+        {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+} // (anon)
+
+GlobPattern::
+GlobPattern(std::string_view pattern)
+{
+    pattern_.reserve(pattern.size());
+    segments_.emplace_back();
+    for (char c : pattern)
     {
-        if (pattern.size() == 1)
+        if (c != '*')
         {
-            return true;
+            pattern_.push_back(c);
+            segments_.back().push_back(c);
+            ++minSize_;
+            hasQuestion_ |= c == '?';
+            continue;
         }
-        for (std::size_t i = 0; i <= str.size(); ++i)
+        if (!pattern_.empty() && pattern_.back() == '*')
         {
-            if (globMatch(pattern.substr(1), str.substr(i)))
-            {
-                return true;
-            }
+            continue;
         }
+        pattern_.push_back(c);
+        segments_.emplace_back();
+        hasStar_ = true;
+    }
+}
+
+bool
+GlobPattern::
+matches(std::string_view str) const noexcept
+{
+    if (str.size() < minSize_)
+    {
         return false;
     }
-    if (str.empty())
+    if (!hasStar_)
+    {
+        if (!hasQuestion_)
+        {
+            return str == pattern_;
+        }
+        return str.size() == minSize_ &&
+            matchesAt(pattern_, str);
+    }
+
+    // The first and last segments are anchored
+    std::string_view const prefix = segments_.front();
+    std::string_view const suffix = segments_.back();
+    if (!matchesAt(prefix, str) ||
+        !matchesAt(suffix, str.substr(str.size() - suffix.size())))
     {
         return false;
     }
-    if (pattern[0] == str[0] || pattern[0] == '?')
+    str = str.substr(prefix.size(), str.size() -
+        prefix.size() - suffix.size());
+
+    // The leftmost match of each segment in between
+    // leaves the most room for the segments after it
+    for (std::size_t i = 1; i + 1 < segments_.size(); ++i)
     {
-        return globMatch(pattern.substr(1), str.substr(1));
+        std::string_view const segment = segments_[i];
+        std::size_t const pos = findSegment(segment, str);
+        if (pos == std::string_view::npos)
+        {
+            return false;
+        }
+        str.remove_prefix(pos + segment.size());
     }
-    return false;
+    return true;
 }
 
 } // mrdocs
@@ -11,19 +11,77 @@
 #ifndef MRDOCS_LIB_SUPPORT_GLOB_HPP
 #define MRDOCS_LIB_SUPPORT_GLOB_HPP
 
+#include <mrdocs/Platform.hpp>
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
 
-/// Check if the string matches the glob pattern
-bool
-globMatch(
-    std::string_view pattern,
-    std::string_view str) noexcept;
+/** A compiled glob pattern.
+
+    The pattern may contain the wildcards `*`,
+    which matches any sequence of characters, and
+    `?`, which matches any single character.
+
+    The pattern is split once into the literal
+    segments between each `*`, so that matching
+    takes a single left-to-right pass over the
+    string without backtracking.
+*/
+class MRDOCS_DECL
+    GlobPattern
+{
+    // the pattern, with consecutive '*' collapsed
+    std::string pattern_;
+    // the segments separated by '*'
+    std::vector<std::string> segments_;
+    // the length of the shortest matching string
+    std::size_t minSize_ = 0;
+    bool hasStar_ = false;
+    bool hasQuestion_ = false;
+
+public:
+    /** Construct a pattern which matches the empty string.
+    */
+    GlobPattern() = default;
+
+    /** Compile a pattern.
+    */
+    explicit
+    GlobPattern(std::string_view pattern);
+
+    /** Return the pattern string.
+    */
+    std::string_view
+    pattern() const noexcept
+    {
+        return pattern_;
+    }
+
+    /** Return true if the pattern contains no wildcards.
+    */
+    bool
+    isLiteral() const noexcept
+    {
+        return !hasStar_ && !hasQuestion_;
+    }
+
+    /** Return true if the string matches the pattern.
+    */
+    bool
+    matches(std::string_view str) const noexcept;
+
+    bool
+    operator==(GlobPattern const& other) const noexcept
+    {
+        return pattern_ == other.pattern_;
+    }
+};
 
 } // mrdocs
 } // clang
 
 #endif // MRDOCS_LIB_SUPPORT_GLOB_HPP
-
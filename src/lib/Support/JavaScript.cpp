@@ -10,6 +10,7 @@
 //
 
 #include "lib/Support/Error.hpp"
+#include "lib/Support/Stats.hpp"
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/JavaScript.hpp>
 #include <mrdocs/Support/Handlebars.hpp>
@@ -1934,7 +1935,9 @@ registerHelper(
             {
                 arg_span.push_back(arg);
             }
+            Stats::Timer timer;
             auto JSResult = fn.apply(arg_span);
+            Stats::get().addHelper(name, timer.elapsed());
             if (!JSResult)
             {
                 return dom::Kind::Undefined;
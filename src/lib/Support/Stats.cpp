@@ -0,0 +1,285 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "Stats.hpp"
+#include "lib/Support/Error.hpp"
+#include <mrdocs/Version.hpp>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+namespace clang {
+namespace mrdocs {
+
+std::uint64_t
+peakResidentBytes() noexcept
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if(! GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return 0;
+    return pmc.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    // bytes on macOS
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    // kilobytes elsewhere
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+std::uint64_t
+currentResidentBytes() noexcept
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if(! GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return 0;
+    return pmc.WorkingSetSize;
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+        reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size;
+#else
+    // The second field is the number of resident pages
+    std::FILE* file = std::fopen("/proc/self/statm", "r");
+    if(! file)
+        return 0;
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    int const n = std::fscanf(file, "%llu %llu", &size, &resident);
+    std::fclose(file);
+    long const pageSize = sysconf(_SC_PAGESIZE);
+    if(n != 2 || pageSize <= 0)
+        return 0;
+    return resident * static_cast<std::uint64_t>(pageSize);
+#endif
+}
+
+namespace {
+
+double
+toMilliseconds(Stats::duration d) noexcept
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+} // (anon)
+
+Stats&
+Stats::
+get() noexcept
+{
+    static Stats stats;
+    return stats;
+}
+
+void
+Stats::
+addTranslationUnit(TranslationUnit tu)
+{
+    if(! enabled())
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    translationUnits_.push_back(std::move(tu));
+}
+
+void
+Stats::
+addPhase(
+    std::string_view name,
+    duration time)
+{
+    if(! enabled())
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = phases_.find(name);
+    if(it == phases_.end())
+        it = phases_.emplace(std::string(name), duration{}).first;
+    it->second += time;
+}
+
+void
+Stats::
+addRender(
+    std::string_view generator,
+    std::string_view layout,
+    duration time)
+{
+    if(! enabled())
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto git = renders_.find(generator);
+    if(git == renders_.end())
+        git = renders_.try_emplace(std::string(generator)).first;
+    auto lit = git->second.find(layout);
+    if(lit == git->second.end())
+        lit = git->second.try_emplace(std::string(layout)).first;
+    ++lit->second.count;
+    lit->second.time += time;
+}
+
+void
+Stats::
+addHelper(
+    std::string_view name,
+    duration time)
+{
+    if(! enabled())
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = helpers_.find(name);
+    if(it == helpers_.end())
+        it = helpers_.try_emplace(std::string(name)).first;
+    ++it->second.count;
+    it->second.time += time;
+}
+
+void
+Stats::
+addCounter(
+    std::string_view name,
+    std::uint64_t n)
+{
+    if(! enabled())
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = counters_.find(name);
+    if(it == counters_.end())
+        it = counters_.emplace(std::string(name), 0).first;
+    it->second += n;
+}
+
+std::vector<Stats::TranslationUnit>
+Stats::
+takeTranslationUnits()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::exchange(translationUnits_, {});
+}
+
+std::map<std::string, std::uint64_t, std::less<>>
+Stats::
+takeCounters()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::exchange(counters_, {});
+}
+
+Expected<void>
+Stats::
+write(std::string_view path) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(auto err = llvm::writeToOutput(path,
+        [&](llvm::raw_ostream& os)
+        {
+            // Durations are written in milliseconds
+            llvm::json::OStream J(os, 2);
+            J.object([&]
+            {
+                J.attribute("version", std::string(project_version));
+
+                J.attributeArray("translation-units", [&]
+                {
+                    for(TranslationUnit const& tu : translationUnits_)
+                    {
+                        J.object([&]
+                        {
+                            J.attribute("file", tu.file);
+                            J.attribute("preprocess", toMilliseconds(tu.preprocess));
+                            J.attribute("parse", toMilliseconds(tu.parse));
+                            J.attribute("traverse", toMilliseconds(tu.traverse));
+                            J.attribute("dependencies", toMilliseconds(tu.dependencies));
+                            J.attribute("symbol-ids", toMilliseconds(tu.symbolIds));
+                            J.attribute("queue-wait", toMilliseconds(tu.queueWait));
+                        });
+                    }
+                });
+
+                J.attributeObject("phases", [&]
+                {
+                    for(auto const& [name, time] : phases_)
+                        J.attribute(name, toMilliseconds(time));
+                });
+
+                J.attributeObject("generators", [&]
+                {
+                    for(auto const& [generator, layouts] : renders_)
+                    {
+                        J.attributeObject(generator, [&]
+                        {
+                            for(auto const& [layout, counter] : layouts)
+                            {
+                                J.attributeObject(layout, [&]
+                                {
+                                    J.attribute("pages", counter.count);
+                                    J.attribute("time", toMilliseconds(counter.time));
+                                });
+                            }
+                        });
+                    }
+                });
+
+                J.attributeObject("helpers", [&]
+                {
+                    for(auto const& [name, counter] : helpers_)
+                    {
+                        J.attributeObject(name, [&]
+                        {
+                            J.attribute("calls", counter.count);
+                            J.attribute("time", toMilliseconds(counter.time));
+                        });
+                    }
+                });
+
+                J.attributeObject("counters", [&]
+                {
+                    for(auto const& [name, n] : counters_)
+                        J.attribute(name, n);
+                });
+
+                J.attribute("bytes-written", bytesWritten_.load());
+                J.attribute("peak-rss", peakResidentBytes());
+            });
+            os << '\n';
+            return llvm::Error::success();
+        }))
+    {
+        return Unexpected(toError(std::move(err)));
+    }
+    return {};
+}
+
+} // mrdocs
+} // clang
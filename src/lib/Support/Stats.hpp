@@ -0,0 +1,215 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_SUPPORT_STATS_HPP
+#define MRDOCS_LIB_SUPPORT_STATS_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** Performance statistics collected during a run.
+
+    A single instance collects the statistics
+    of every phase of the pipeline, and is written
+    as JSON when the `stats` option is set.
+
+    Collection is disabled by default, in which
+    case the recording functions return without
+    doing anything.
+*/
+class MRDOCS_DECL
+    Stats
+{
+public:
+    using duration = std::chrono::nanoseconds;
+
+    /** The times spent on one translation unit.
+    */
+    struct TranslationUnit
+    {
+        /// The full path of the main file
+        std::string file;
+
+        /// Creating the preprocessor, including predefines and any PCH
+        duration preprocess{};
+
+        /// Lexing, preprocessing, and parsing the source
+        duration parse{};
+
+        /// Traversing the declarations of the translation unit
+        duration traverse{};
+
+        /// Traversing the declarations extracted as dependencies
+        duration dependencies{};
+
+        /// Generating and hashing USRs, included in the traversals
+        duration symbolIds{};
+
+        /// Waiting for room in the bounded queue of results to merge
+        duration queueWait{};
+    };
+
+    /** Measures the time elapsed since construction.
+    */
+    class Timer
+    {
+        std::chrono::steady_clock::time_point start_ =
+            std::chrono::steady_clock::now();
+
+    public:
+        duration
+        elapsed() const noexcept
+        {
+            return std::chrono::duration_cast<duration>(
+                std::chrono::steady_clock::now() - start_);
+        }
+    };
+
+    /** Return the statistics of the process.
+    */
+    static
+    Stats&
+    get() noexcept;
+
+    /** Enable the collection of statistics.
+    */
+    void
+    enable() noexcept
+    {
+        enabled_ = true;
+    }
+
+    /** Return true if statistics are being collected.
+    */
+    bool
+    enabled() const noexcept
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /** Record the times of a translation unit.
+    */
+    void
+    addTranslationUnit(TranslationUnit tu);
+
+    /** Add to the time spent in a phase of the pipeline.
+    */
+    void
+    addPhase(
+        std::string_view name,
+        duration time);
+
+    /** Record a page rendered with a layout.
+
+        @param generator The id of the generator.
+        @param layout The name of the layout template.
+        @param time The time spent rendering the page.
+    */
+    void
+    addRender(
+        std::string_view generator,
+        std::string_view layout,
+        duration time);
+
+    /** Record a call to a JavaScript helper.
+    */
+    void
+    addHelper(
+        std::string_view name,
+        duration time);
+
+    /** Add to a named counter.
+    */
+    void
+    addCounter(
+        std::string_view name,
+        std::uint64_t n);
+
+    /** Remove and return the translation units recorded so far.
+
+        This is used by worker processes to send
+        their statistics to the parent process.
+    */
+    std::vector<TranslationUnit>
+    takeTranslationUnits();
+
+    /** Remove and return the counters recorded so far.
+
+        This is used by worker processes to send
+        their statistics to the parent process.
+    */
+    std::map<std::string, std::uint64_t, std::less<>>
+    takeCounters();
+
+    /** Record bytes written to output files.
+    */
+    void
+    addBytesWritten(std::uint64_t n) noexcept
+    {
+        if(enabled())
+            bytesWritten_ += n;
+    }
+
+    /** Write the statistics to a JSON file.
+    */
+    Expected<void>
+    write(std::string_view path) const;
+
+private:
+    struct Counter
+    {
+        std::uint64_t count = 0;
+        duration time{};
+    };
+
+    std::atomic<bool> enabled_ = false;
+    std::atomic<std::uint64_t> bytesWritten_ = 0;
+
+    mutable std::mutex mutex_;
+    std::vector<TranslationUnit> translationUnits_;
+    std::map<std::string, duration, std::less<>> phases_;
+    std::map<std::string, std::map<std::string, Counter, std::less<>>, std::less<>> renders_;
+    std::map<std::string, Counter, std::less<>> helpers_;
+    std::map<std::string, std::uint64_t, std::less<>> counters_;
+};
+
+/** Return the peak resident set size of the process in bytes.
+
+    Zero is returned if it cannot be determined.
+*/
+MRDOCS_DECL
+std::uint64_t
+peakResidentBytes() noexcept;
+
+/** Return the current resident set size of the process in bytes.
+
+    Unlike the peak, this is not inherited by
+    a child process from its parent. Zero is
+    returned if it cannot be determined.
+*/
+MRDOCS_DECL
+std::uint64_t
+currentResidentBytes() noexcept;
+
+} // mrdocs
+} // clang
+
+#endif
@@ -10,15 +10,396 @@
 
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/ThreadPool.hpp>
-#include <llvm/Support/Signals.h>
-#include <llvm/Support/ThreadPool.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <optional>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 
 namespace clang {
 namespace mrdocs {
 
+namespace {
+
+constexpr std::size_t priorityCount = 3;
+
+std::size_t
+laneIndex(TaskPriority priority) noexcept
+{
+    return static_cast<std::size_t>(priority);
+}
+
+} // (anon)
+
+//------------------------------------------------
+//
+// TaskGroup::Impl
+//
+//------------------------------------------------
+
+struct TaskGroup::
+    Impl
+{
+    ThreadPool::Impl* pool;
+    TaskPriority priority;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::unordered_set<Error> errors;
+    std::size_t pending = 0;
+
+    Impl(
+        ThreadPool::Impl* pool_,
+        TaskPriority priority_) noexcept
+        : pool(pool_)
+        , priority(priority_)
+    {
+    }
+
+    void
+    addError(Error err)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.emplace(std::move(err));
+    }
+
+    void
+    runInline(any_callable<void(void)>& f)
+    {
+        try
+        {
+            f();
+        }
+        catch(Exception const& ex)
+        {
+            errors.emplace(ex.error());
+        }
+        catch(std::exception const& ex)
+        {
+            errors.emplace(Error(ex));
+        }
+    }
+
+    /** Record the completion of a task.
+
+        @return `true` if no work of the group
+        remains.
+    */
+    bool
+    finish()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--pending != 0)
+            return false;
+        cv.notify_all();
+        return true;
+    }
+};
+
+//------------------------------------------------
+//
+// ThreadPool::Impl
+//
+//------------------------------------------------
+
+struct ThreadPool::
+    Impl
+{
+    /** A unit of work.
+
+        Work submitted through a TaskGroup records
+        the group, so that errors can be collected
+        and the group notified on completion.
+    */
+    struct Task
+    {
+        any_callable<void(void)> fn;
+        TaskGroup::Impl* group = nullptr;
+    };
+
+    using Lanes = std::array<std::deque<Task>, priorityCount>;
+
+    /** The queues owned by one thread.
+    */
+    struct Worker
+    {
+        std::mutex mutex;
+        Lanes lanes;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    // Protects shared, stop, generation,
+    // and the condition variables
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    Lanes shared;
+    bool stop = false;
+
+    // Incremented when a group or the pool runs out
+    // of work. Threads of the pool which wait from
+    // within work are woken by this, or by new work.
+    std::size_t generation = 0;
+
+    std::atomic<std::size_t> queued = 0;
+    std::atomic<std::size_t> pending = 0;
+
+    // The pool and index of the current thread
+    static thread_local Impl* currentPool;
+    static thread_local std::size_t currentIndex;
+
+    explicit
+    Impl(unsigned concurrency)
+    {
+        workers.reserve(concurrency);
+        for(unsigned i = 0; i < concurrency; ++i)
+            workers.emplace_back(std::make_unique<Worker>());
+        threads.reserve(concurrency);
+        for(unsigned i = 0; i < concurrency; ++i)
+            threads.emplace_back([this, i]{ runWorker(i); });
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        workAvailable.notify_all();
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    bool
+    onWorkerThread() const noexcept
+    {
+        return currentPool == this;
+    }
+
+    void
+    push(Task task, TaskPriority priority)
+    {
+        ++pending;
+        std::size_t const lane = laneIndex(priority);
+        if(onWorkerThread())
+        {
+            Worker& w = *workers[currentIndex];
+            std::lock_guard<std::mutex> lock(w.mutex);
+            w.lanes[lane].push_back(std::move(task));
+            ++queued;
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shared[lane].push_back(std::move(task));
+            ++queued;
+        }
+        // Taking the lock ensures a thread which
+        // just found nothing to do is already
+        // waiting, so the notification is not lost
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+        workAvailable.notify_one();
+    }
+
+    /** Return the next task for a thread, if any.
+
+        For each priority in turn, the thread tries
+        its own queue, then the shared queue, and
+        then steals from the other threads.
+    */
+    std::optional<Task>
+    pop(std::optional<std::size_t> self)
+    {
+        if(queued.load() == 0)
+            return std::nullopt;
+        for(std::size_t lane = 0; lane < priorityCount; ++lane)
+        {
+            if(self)
+            {
+                Worker& w = *workers[*self];
+                std::lock_guard<std::mutex> lock(w.mutex);
+                auto& q = w.lanes[lane];
+                if(! q.empty())
+                {
+                    Task task = std::move(q.back());
+                    q.pop_back();
+                    --queued;
+                    return task;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto& q = shared[lane];
+                if(! q.empty())
+                {
+                    Task task = std::move(q.front());
+                    q.pop_front();
+                    --queued;
+                    return task;
+                }
+            }
+            std::size_t const start = self ? *self + 1 : 0;
+            for(std::size_t i = 0; i < workers.size(); ++i)
+            {
+                std::size_t const victim = (start + i) % workers.size();
+                if(self && victim == *self)
+                    continue;
+                Worker& w = *workers[victim];
+                std::lock_guard<std::mutex> lock(w.mutex);
+                auto& q = w.lanes[lane];
+                if(! q.empty())
+                {
+                    Task task = std::move(q.front());
+                    q.pop_front();
+                    --queued;
+                    return task;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    void
+    run(Task& task)
+    {
+        if(task.group)
+        {
+            // The function object is destroyed before
+            // the group is notified, since its captures
+            // may refer to objects owned by the waiter
+            TaskGroup::Impl* group = task.group;
+            try
+            {
+                any_callable<void(void)> fn(std::move(task.fn));
+                fn();
+            }
+            catch(Exception const& ex)
+            {
+                group->addError(ex.error());
+            }
+            catch(std::exception const& ex)
+            {
+                group->addError(Error(ex));
+            }
+            // The group may be destroyed by its
+            // waiter once it is finished
+            if(group->finish())
+                notifyWaiters();
+        }
+        else
+        {
+            // do NOT catch exceptions here
+            task.fn();
+        }
+        if(--pending == 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++generation;
+                allDone.notify_all();
+            }
+            workAvailable.notify_all();
+        }
+    }
+
+    /** Wake the threads of the pool waiting within work.
+    */
+    void
+    notifyWaiters()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++generation;
+        }
+        workAvailable.notify_all();
+    }
+
+    void
+    runWorker(std::size_t index)
+    {
+        currentPool = this;
+        currentIndex = index;
+        for(;;)
+        {
+            if(auto task = pop(index))
+            {
+                run(*task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock,
+                [&]
+                {
+                    return stop || queued.load() != 0;
+                });
+            if(stop && queued.load() == 0)
+                return;
+        }
+    }
+
+    /** Block until a condition holds.
+
+        A thread of the pool runs queued work while
+        it waits, so that waiting from within
+        submitted work cannot exhaust the pool.
+        Between tasks, it sleeps until work is
+        queued or some group runs out of work.
+    */
+    template<class Pred>
+    void
+    waitUntil(
+        std::mutex& m,
+        std::condition_variable& cv,
+        Pred const& pred)
+    {
+        if(! onWorkerThread())
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, pred);
+            return;
+        }
+        for(;;)
+        {
+            // The generation is read before the condition,
+            // so a change of the condition after it is
+            // checked also changes the generation
+            std::size_t seen;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                seen = generation;
+            }
+            {
+                std::unique_lock<std::mutex> lock(m);
+                if(pred())
+                    return;
+            }
+            if(auto task = pop(currentIndex))
+            {
+                run(*task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock,
+                [&]
+                {
+                    return queued.load() != 0 || generation != seen;
+                });
+        }
+    }
+};
+
+thread_local ThreadPool::Impl* ThreadPool::Impl::currentPool = nullptr;
+thread_local std::size_t ThreadPool::Impl::currentIndex = 0;
+
 //------------------------------------------------
 //
 // ThreadPool
@@ -35,13 +416,10 @@ ThreadPool::
 ThreadPool(
     unsigned concurrency)
 {
+    if(concurrency == 0)
+        concurrency = std::max(std::thread::hardware_concurrency(), 1u);
     if(concurrency != 1)
-    {
-        llvm::ThreadPoolStrategy S;
-        S.ThreadsRequested = concurrency;
-        S.Limit = true;
-        impl_ = std::make_unique<llvm::StdThreadPool>(S);
-    }
+        impl_ = std::make_unique<Impl>(concurrency);
 }
 
 unsigned
@@ -49,7 +427,7 @@ ThreadPool::
 getThreadCount() const noexcept
 {
     if(impl_)
-        return impl_->getMaxConcurrency();
+        return static_cast<unsigned>(impl_->threads.size());
     return 1;
 }
 
@@ -57,24 +435,24 @@ void
 ThreadPool::
 wait()
 {
-    if( impl_)
-        impl_->wait();
+    if(! impl_)
+        return;
+    impl_->waitUntil(impl_->mutex, impl_->allDone,
+        [&]
+        {
+            return impl_->pending.load() == 0;
+        });
 }
 
 void
 ThreadPool::
 post(
-    any_callable<void(void)> f)
+    any_callable<void(void)> f,
+    TaskPriority priority)
 {
     if(impl_)
     {
-        impl_->async(
-        [sp = std::make_shared<
-            any_callable<void(void)>>(std::move(f))]
-        {
-            // do NOT catch exceptions here
-            (*sp)();
-        });
+        impl_->push({ std::move(f) }, priority);
         return;
     }
 
@@ -88,33 +466,15 @@ post(
 //
 //------------------------------------------------
 
-struct TaskGroup::
-    Impl
-{
-    std::mutex mutex;
-    std::unordered_set<Error> errors;
-    std::unique_ptr<
-        llvm::ThreadPoolTaskGroup> taskGroup;
-
-    explicit
-    Impl(
-        llvm::StdThreadPool* threadPool)
-        : taskGroup(threadPool
-            ? std::make_unique<
-                llvm::ThreadPoolTaskGroup>(*threadPool)
-            : nullptr)
-    {
-    }
-};
-
 TaskGroup::
 ~TaskGroup() = default;
 
 TaskGroup::
 TaskGroup(
-    ThreadPool& threadPool)
+    ThreadPool& threadPool,
+    TaskPriority priority)
     : impl_(std::make_unique<Impl>(
-        threadPool.impl_.get()))
+        threadPool.impl_.get(), priority))
 {
 }
 
@@ -122,16 +482,20 @@ std::vector<Error>
 TaskGroup::
 wait()
 {
-    if( impl_->taskGroup)
-        impl_->taskGroup->wait();
+    if(impl_->pool)
+    {
+        impl_->pool->waitUntil(impl_->mutex, impl_->cv,
+            [&]
+            {
+                return impl_->pending == 0;
+            });
+    }
 
     // VFALCO We could have a small data race here
     // where another thread posts work after the
     // wait is satisfied, but that could be
     // considered user error.
     //
-    // In theory the lock should not be needed.
-    //
     std::lock_guard<std::mutex> lock(impl_->mutex);
     std::vector<Error> errors;
     errors.reserve(impl_->errors.size());
@@ -146,42 +510,29 @@ TaskGroup::
 post(
     any_callable<void(void)> f)
 {
-    if(impl_->taskGroup)
+    post(std::move(f), impl_->priority);
+}
+
+void
+TaskGroup::
+post(
+    any_callable<void(void)> f,
+    TaskPriority priority)
+{
+    if(impl_->pool)
     {
-        impl_->taskGroup->async(
-        [&, sp = std::make_shared<
-            any_callable<void(void)>>(std::move(f))]
         {
-            try
-            {
-                (*sp)();
-            }
-            catch(Exception const& ex)
-            {
-                std::lock_guard<std::mutex> lock(impl_->mutex);
-                impl_->errors.emplace(ex.error());
-            }
-            catch(std::exception const& ex)
-            {
-                std::lock_guard<std::mutex> lock(impl_->mutex);
-                impl_->errors.emplace(Error(ex));
-            }
-        });
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            ++impl_->pending;
+        }
+        impl_->pool->push({ std::move(f), impl_.get() }, priority);
         return;
     }
 
-    try
-    {
-        f();
-    }
-    catch(Exception const& ex)
-    {
-        impl_->errors.emplace(ex.error());
-    }
-    catch(std::exception const& ex)
-    {
-        impl_->errors.emplace(Error(ex));
-    }
+    // Without a pool, work runs on the calling
+    // thread before post returns, including work
+    // submitted from within work
+    impl_->runInline(f);
 }
 
 } // mrdocs
@@ -0,0 +1,184 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/ConfigImpl.hpp"
+#include <mrdocs/Corpus.hpp>
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+struct Corpus_test
+{
+    /** A corpus of namespaces, without indexes.
+    */
+    class TestCorpus
+        : public Corpus
+    {
+        std::vector<std::unique_ptr<NamespaceInfo>> info_;
+        std::vector<Info const*> index_;
+
+    public:
+        TestCorpus(
+            Config const& config,
+            std::size_t n)
+            : Corpus(config)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                std::array<std::uint8_t, 20> bytes{};
+                for (std::size_t j = 0; j < sizeof(i); ++j)
+                {
+                    bytes[j] = static_cast<std::uint8_t>(i >> (8 * j));
+                }
+                auto I = std::make_unique<NamespaceInfo>(
+                    SymbolID(bytes.data()));
+                index_.push_back(I.get());
+                info_.push_back(std::move(I));
+            }
+        }
+
+        iterator
+        begin() const noexcept override
+        {
+            return iterator(index_.data());
+        }
+
+        iterator
+        end() const noexcept override
+        {
+            return iterator(index_.data() + index_.size());
+        }
+
+        Info const*
+        find(SymbolID const&) const noexcept override
+        {
+            return nullptr;
+        }
+
+        std::span<Info const* const>
+        findByKind(InfoKind) const noexcept override
+        {
+            return {};
+        }
+
+        std::span<Info const* const>
+        findByName(std::string_view) const noexcept override
+        {
+            return {};
+        }
+
+        std::span<Info const* const>
+        findByFile(std::string_view) const noexcept override
+        {
+            return {};
+        }
+
+        std::span<std::string_view const>
+        indexedNames() const noexcept override
+        {
+            return {};
+        }
+
+        std::span<std::string_view const>
+        indexedFiles() const noexcept override
+        {
+            return {};
+        }
+    };
+
+    ThreadPool serialPool_;
+    std::shared_ptr<ConfigImpl const> config_ =
+        ConfigImpl::load({}, {}, serialPool_).value();
+
+    // Every symbol is visited exactly once
+    void
+    checkVisits(
+        ThreadPool& threadPool,
+        std::size_t n)
+    {
+        TestCorpus const corpus(*config_, n);
+        std::unordered_map<Info const*, std::size_t> positions;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            positions.emplace(&corpus[i], i);
+        }
+
+        std::vector<std::atomic<std::size_t>> visits(n);
+        auto errors = corpus.parallelForEach(threadPool,
+            [&](Info const& I)
+            {
+                ++visits[positions.at(&I)];
+            });
+        BOOST_TEST(errors.empty());
+        BOOST_TEST(std::ranges::all_of(visits,
+            [](std::atomic<std::size_t> const& v)
+            {
+                return v.load() == 1;
+            }));
+    }
+
+    void
+    testVisits()
+    {
+        ThreadPool threadPool(4);
+        for (std::size_t n : { 0, 1, 3, 16, 17, 1000 })
+        {
+            checkVisits(threadPool, n);
+            checkVisits(serialPool_, n);
+        }
+    }
+
+    void
+    testErrors()
+    {
+        ThreadPool threadPool(4);
+        TestCorpus const corpus(*config_, 100);
+        Info const* const failing = &corpus[42];
+        std::atomic<std::size_t> count = 0;
+        auto errors = corpus.parallelForEach(threadPool,
+            [&](Info const& I)
+            {
+                if (&I == failing)
+                {
+                    formatError("failed").Throw();
+                }
+                ++count;
+            });
+
+        // Only the range of the failing symbol stops at
+        // the error, and there are sixteen ranges of at
+        // most seven symbols on four threads
+        BOOST_TEST(errors.size() == 1);
+        BOOST_TEST(count.load() < 100);
+        BOOST_TEST(count.load() >= 100 - 7);
+    }
+
+    void run()
+    {
+        testVisits();
+        testErrors();
+    }
+};
+
+TEST_SUITE(
+    Corpus_test,
+    "clang.mrdocs.Corpus");
+
+} // mrdocs
+} // clang
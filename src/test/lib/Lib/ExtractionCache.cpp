@@ -0,0 +1,205 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/ExtractionCache.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <test_suite/test_suite.hpp>
+
+namespace clang {
+namespace mrdocs {
+
+struct ExtractionCache_test
+{
+    ThreadPool threadPool_;
+    std::shared_ptr<ConfigImpl const> config_ =
+        ConfigImpl::load({}, {}, threadPool_).value();
+
+    /** A temporary directory, removed with its contents.
+    */
+    class TempDir
+    {
+        llvm::SmallString<128> path_;
+
+    public:
+        TempDir()
+        {
+            llvm::sys::fs::createUniqueDirectory(
+                "mrdocs-cache-test", path_);
+        }
+
+        ~TempDir()
+        {
+            llvm::sys::fs::remove_directories(path_);
+        }
+
+        std::string
+        path() const
+        {
+            return std::string(path_.str());
+        }
+    };
+
+    static
+    bool
+    writeFile(
+        std::string const& path,
+        std::string_view text)
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(path, ec);
+        if (ec)
+        {
+            return false;
+        }
+        os << text;
+        return true;
+    }
+
+    static
+    tooling::CompileCommand
+    makeCommand(std::vector<std::string> args)
+    {
+        return tooling::CompileCommand(
+            "/src", "/src/a.cpp", std::move(args), "");
+    }
+
+    void
+    testKey()
+    {
+        TempDir dir;
+        ExtractionCache cache(dir.path(), *config_);
+        auto const key = [&](std::vector<std::string> args)
+        {
+            return cache.key({ makeCommand(std::move(args)) });
+        };
+
+        // The output file does not change the key
+        std::string const k = key({ "clang", "-c", "a.cpp", "-o", "a.o" });
+        BOOST_TEST(k == key({ "clang", "-c", "a.cpp", "-o", "b.o" }));
+        BOOST_TEST(k == key({ "clang", "-c", "a.cpp", "-ob.o" }));
+        BOOST_TEST(k == key({ "clang", "-c", "a.cpp" }));
+
+        // Other arguments do
+        BOOST_TEST(k != key({ "clang", "-c", "a.cpp", "-DX", "-o", "a.o" }));
+        BOOST_TEST(k != key({ "clang", "-c", "b.cpp", "-o", "a.o" }));
+    }
+
+    void
+    testContentHash()
+    {
+        TempDir dir;
+        std::string const source = files::appendPath(dir.path(), "a.cpp");
+        if (!BOOST_TEST(writeFile(source, "int x;")))
+        {
+            return;
+        }
+
+        std::string key;
+        {
+            ExtractionCache cache(dir.path(), *config_);
+            key = cache.key({ makeCommand({ "clang", "a.cpp" }) });
+            BOOST_TEST(!cache.load(key));
+            BOOST_TEST(cache.misses() == 1);
+
+            InfoSet info;
+            info.emplace(std::make_unique<NamespaceInfo>(SymbolID::global));
+            Diagnostics diags;
+            diags.warn("warning");
+            BOOST_TEST(cache.store(key, { source }, info, diags));
+
+            auto entry = cache.load(key);
+            if (BOOST_TEST(entry))
+            {
+                BOOST_TEST(entry->info.size() == 1);
+                BOOST_TEST(entry->diags.messages().size() == 1);
+            }
+            BOOST_TEST(cache.hits() == 1);
+        }
+
+        // The hashes are computed once per run,
+        // so a new cache sees the changed file
+        if (!BOOST_TEST(writeFile(source, "int y;")))
+        {
+            return;
+        }
+        {
+            ExtractionCache cache(dir.path(), *config_);
+            BOOST_TEST(!cache.load(key));
+            BOOST_TEST(cache.hits() == 0);
+            BOOST_TEST(cache.misses() == 1);
+        }
+
+        // A missing file is a change too
+        llvm::sys::fs::remove(source);
+        {
+            ExtractionCache cache(dir.path(), *config_);
+            BOOST_TEST(!cache.load(key));
+        }
+
+        if (!BOOST_TEST(writeFile(source, "int x;")))
+        {
+            return;
+        }
+        {
+            ExtractionCache cache(dir.path(), *config_);
+            BOOST_TEST(cache.load(key));
+        }
+    }
+
+    void
+    testCorrupt()
+    {
+        TempDir dir;
+        ExtractionCache cache(dir.path(), *config_);
+        std::string const key = cache.key({ makeCommand({ "clang", "a.cpp" }) });
+        std::string const entryPath = files::appendPath(
+            dir.path(), key + ".tu");
+
+        InfoSet info;
+        info.emplace(std::make_unique<NamespaceInfo>(SymbolID::global));
+        BOOST_TEST(cache.store(key, {}, info, Diagnostics()));
+        BOOST_TEST(cache.load(key));
+
+        // A truncated entry is ignored
+        auto text = files::getFileText(entryPath);
+        if (!BOOST_TEST(text))
+        {
+            return;
+        }
+        BOOST_TEST(writeFile(entryPath,
+            std::string_view(*text).substr(0, text->size() - 1)));
+        BOOST_TEST(!cache.load(key));
+
+        // And so is an entry which is not one
+        BOOST_TEST(writeFile(entryPath, "not a cache entry"));
+        BOOST_TEST(!cache.load(key));
+        BOOST_TEST(cache.hits() == 1);
+        BOOST_TEST(cache.misses() == 2);
+    }
+
+    void run()
+    {
+        testKey();
+        testContentHash();
+        testCorrupt();
+    }
+};
+
+TEST_SUITE(
+    ExtractionCache_test,
+    "clang.mrdocs.ExtractionCache");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,195 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/WorkerPool.hpp"
+#include "lib/Support/Stats.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace clang {
+namespace mrdocs {
+
+#if !defined(_WIN32)
+
+struct WorkerPool_test
+{
+    /** Counts the results reported by the workers.
+    */
+    class CountingContext
+        : public ExecutionContext
+    {
+    public:
+        using ExecutionContext::ExecutionContext;
+
+        std::size_t infos = 0;
+        std::size_t warnings = 0;
+
+        void
+        report(
+            InfoSet&& info,
+            Diagnostics&& diags) override
+        {
+            infos += info.size();
+            warnings += diags.messages().size();
+        }
+
+        void
+        reportEnd(report::Level) override
+        {
+        }
+
+        mrdocs::Expected<InfoSet>
+        results() override
+        {
+            return InfoSet();
+        }
+    };
+
+    // The task of the workers, which
+    // does what the request says
+    static
+    void
+    runTask(
+        std::string_view request,
+        ExecutionContext& context)
+    {
+        if (request == "exit")
+        {
+            _exit(1);
+        }
+        if (request == "throw")
+        {
+            formatError("task failed").Throw();
+        }
+        if (request == "stats")
+        {
+            Stats::TranslationUnit tu;
+            tu.file = "a.cpp";
+            tu.parse = std::chrono::milliseconds(5);
+            Stats::get().addTranslationUnit(std::move(tu));
+            Stats::get().addCounter("worker-test", 3);
+        }
+        InfoSet info;
+        info.emplace(std::make_unique<NamespaceInfo>(SymbolID::global));
+        Diagnostics diags;
+        diags.warn("done");
+        context.report(std::move(info), std::move(diags));
+    }
+
+    ThreadPool threadPool_;
+    std::shared_ptr<ConfigImpl const> config_ =
+        ConfigImpl::load({}, {}, threadPool_).value();
+
+    void
+    testRecycle()
+    {
+        // A worker is replaced after two tasks
+        WorkerPool pool(*config_, runTask, 1, 2, 0);
+        if (!BOOST_TEST(pool.start()))
+        {
+            return;
+        }
+        CountingContext context(*config_);
+        for (int i = 0; i < 5; ++i)
+        {
+            BOOST_TEST(pool.run("ok", context));
+        }
+        BOOST_TEST(context.infos == 5);
+        BOOST_TEST(context.warnings == 5);
+        BOOST_TEST(pool.recycled() == 2);
+        BOOST_TEST(pool.crashes() == 0);
+    }
+
+    void
+    testFailure()
+    {
+        WorkerPool pool(*config_, runTask, 1, 0, 0);
+        if (!BOOST_TEST(pool.start()))
+        {
+            return;
+        }
+        CountingContext context(*config_);
+
+        // A task which throws keeps its worker
+        auto exp = pool.run("throw", context);
+        BOOST_TEST(!exp);
+        if (!exp)
+        {
+            BOOST_TEST(exp.error().reason() == "task failed");
+        }
+        BOOST_TEST(pool.crashes() == 0);
+
+        // The end of a worker fails the task, and
+        // the next task runs on a new worker
+        BOOST_TEST(!pool.run("exit", context));
+        BOOST_TEST(pool.crashes() == 1);
+        BOOST_TEST(pool.run("ok", context));
+        BOOST_TEST(context.infos == 1);
+        BOOST_TEST(pool.recycled() == 0);
+    }
+
+    void
+    testStats()
+    {
+        Stats& stats = Stats::get();
+        stats.enable();
+        stats.takeTranslationUnits();
+        stats.takeCounters();
+
+        WorkerPool pool(*config_, runTask, 1, 0, 0);
+        if (!BOOST_TEST(pool.start()))
+        {
+            return;
+        }
+        CountingContext context(*config_);
+        BOOST_TEST(pool.run("stats", context));
+        BOOST_TEST(pool.run("stats", context));
+
+        // The statistics of the workers are
+        // recorded by the parent process
+        auto const translationUnits = stats.takeTranslationUnits();
+        BOOST_TEST(translationUnits.size() == 2);
+        BOOST_TEST(std::ranges::all_of(translationUnits,
+            [](Stats::TranslationUnit const& tu)
+            {
+                return tu.file == "a.cpp" &&
+                    tu.parse == std::chrono::milliseconds(5);
+            }));
+        auto const counters = stats.takeCounters();
+        auto const it = counters.find("worker-test");
+        if (BOOST_TEST(it != counters.end()))
+        {
+            BOOST_TEST(it->second == 6);
+        }
+    }
+
+    void run()
+    {
+        testRecycle();
+        testFailure();
+        testStats();
+    }
+};
+
+TEST_SUITE(
+    WorkerPool_test,
+    "clang.mrdocs.WorkerPool");
+
+#endif
+
+} // mrdocs
+} // clang
@@ -0,0 +1,151 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Metadata/Serialize.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <test_suite/test_suite.hpp>
+
+namespace clang {
+namespace mrdocs {
+
+struct Serialize_test
+{
+    static
+    std::unique_ptr<TypeInfo>
+    makeNamedType(std::string_view name)
+    {
+        auto N = std::make_unique<NameInfo>();
+        N->Name = name;
+        auto T = std::make_unique<NamedTypeInfo>();
+        T->Name = std::move(N);
+        return T;
+    }
+
+    void
+    testRoundTrip()
+    {
+        SymbolID const recordID("rrrrrrrrrrrrrrrrrrrr");
+        SymbolID const functionID("ffffffffffffffffffff");
+
+        InfoSet info;
+        {
+            auto I = std::make_unique<RecordInfo>(recordID);
+            I->Name = "S";
+            I->KeyKind = RecordKeyKind::Class;
+            I->Namespace.push_back(SymbolID::global);
+            I->Members.push_back(functionID);
+            I->OverloadGroups.push_back({ functionID, 0, 2 });
+            I->OverloadMembers.push_back(functionID);
+            I->OverloadMembers.push_back(recordID);
+            info.emplace(std::move(I));
+        }
+        {
+            auto I = std::make_unique<FunctionInfo>(functionID);
+            I->Name = "f";
+            I->Access = AccessKind::Public;
+            I->Namespace.push_back(recordID);
+            I->Namespace.push_back(SymbolID::global);
+            I->ReturnType = makeNamedType("int");
+            I->Params.emplace_back(makeNamedType("T"), "x", "0");
+            I->Template = std::make_unique<TemplateInfo>();
+            auto P = std::make_unique<TypeTParam>();
+            P->Name = "T";
+            I->Template->Params.push_back(std::move(P));
+            I->Loc.emplace_back("/src/s.hpp", "s.hpp", 42, FileKind::Source, true);
+
+            doc::Paragraph para;
+            para.emplace_back(doc::Text("Hello"));
+            I->javadoc = std::make_unique<Javadoc>();
+            I->javadoc->emplace_back(std::move(para));
+            info.emplace(std::move(I));
+        }
+
+        std::string const data = serializeInfoSet(info);
+        Expected<InfoSet> result = deserializeInfoSet(data);
+        if (!BOOST_TEST(result))
+        {
+            return;
+        }
+        BOOST_TEST(result->size() == 2);
+
+        auto record = result->find(recordID);
+        if (BOOST_TEST(record != result->end()))
+        {
+            auto const& I = static_cast<RecordInfo const&>(**record);
+            BOOST_TEST(I.Name == "S");
+            BOOST_TEST(I.KeyKind == RecordKeyKind::Class);
+            BOOST_TEST(I.Namespace.size() == 1);
+            BOOST_TEST(I.Members.size() == 1);
+            BOOST_TEST(I.Members.front() == functionID);
+            if (BOOST_TEST(I.OverloadGroups.size() == 1))
+            {
+                BOOST_TEST(I.OverloadGroups.front().Member == functionID);
+                BOOST_TEST(I.OverloadGroups.front().First == 0);
+                BOOST_TEST(I.OverloadGroups.front().Count == 2);
+            }
+            BOOST_TEST(I.OverloadMembers.size() == 2);
+        }
+
+        auto function = result->find(functionID);
+        if (BOOST_TEST(function != result->end()))
+        {
+            auto const& I = static_cast<FunctionInfo const&>(**function);
+            BOOST_TEST(I.Name == "f");
+            BOOST_TEST(I.Access == AccessKind::Public);
+            BOOST_TEST(I.Namespace.size() == 2);
+            if (BOOST_TEST(I.ReturnType))
+            {
+                BOOST_TEST(I.ReturnType->isNamed());
+            }
+            BOOST_TEST(I.Params.size() == 1);
+            BOOST_TEST(I.Params.front().Name == "x");
+            BOOST_TEST(I.Params.front().Default == "0");
+            if (BOOST_TEST(I.Template))
+            {
+                BOOST_TEST(I.Template->Params.size() == 1);
+            }
+            BOOST_TEST(I.Loc.size() == 1);
+            BOOST_TEST(I.Loc.front().LineNumber == 42);
+            BOOST_TEST(I.Loc.front().path() == "/src/s.hpp");
+            BOOST_TEST(I.Loc.front().filename() == "s.hpp");
+            if (BOOST_TEST(I.javadoc))
+            {
+                auto const& expected = (*info.find(functionID))->javadoc;
+                BOOST_TEST(*I.javadoc == *expected);
+            }
+        }
+    }
+
+    void
+    testInvalid()
+    {
+        BOOST_TEST(!deserializeInfoSet(""));
+        BOOST_TEST(!deserializeInfoSet("MRDI"));
+
+        InfoSet info;
+        info.emplace(std::make_unique<NamespaceInfo>(SymbolID::global));
+        std::string data = serializeInfoSet(info);
+        data.resize(data.size() - 1);
+        BOOST_TEST(!deserializeInfoSet(data));
+    }
+
+    void run()
+    {
+        testRoundTrip();
+        testInvalid();
+    }
+};
+
+TEST_SUITE(
+    Serialize_test,
+    "clang.mrdocs.Serialize");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,86 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/Glob.hpp"
+#include "lib/Lib/Filters.hpp"
+#include <test_suite/test_suite.hpp>
+#include <string>
+
+namespace clang {
+namespace mrdocs {
+
+struct Glob_test
+{
+    static
+    bool
+    match(std::string_view pattern, std::string_view str)
+    {
+        return GlobPattern(pattern).matches(str);
+    }
+
+    void
+    testGlob()
+    {
+        BOOST_TEST(match("", ""));
+        BOOST_TEST(!match("", "a"));
+        BOOST_TEST(match("*", ""));
+        BOOST_TEST(match("*", "abc"));
+        BOOST_TEST(match("**", "abc"));
+        BOOST_TEST(match("abc", "abc"));
+        BOOST_TEST(!match("abc", "abd"));
+        BOOST_TEST(!match("abc", "abcd"));
+        BOOST_TEST(match("a?c", "abc"));
+        BOOST_TEST(!match("a?c", "ac"));
+        BOOST_TEST(match("*.hpp", "/usr/include/a.hpp"));
+        BOOST_TEST(!match("*.hpp", "/usr/include/a.cpp"));
+        BOOST_TEST(match("/src/*/detail/*", "/src/lib/detail/x.hpp"));
+        BOOST_TEST(!match("/src/*/detail/*", "/src/lib/x.hpp"));
+        BOOST_TEST(match("a*b*c", "abc"));
+        BOOST_TEST(match("a*b*c", "axxbxxbxxc"));
+        BOOST_TEST(!match("a*b*c", "axxbxxbxx"));
+        BOOST_TEST(match("*ab*ab*", "ababab"));
+        BOOST_TEST(!match("aa*aa", "aaa"));
+        BOOST_TEST(match("a*?*c", "abc"));
+        BOOST_TEST(!match("a*?*c", "ac"));
+
+        // Does not take exponential time
+        std::string const str(64, 'a');
+        BOOST_TEST(!match("a*a*a*a*a*a*a*a*a*a*a*a*b", str));
+
+        BOOST_TEST(GlobPattern("a**b") == GlobPattern("a*b"));
+        BOOST_TEST(GlobPattern("abc").isLiteral());
+        BOOST_TEST(!GlobPattern("a?c").isLiteral());
+    }
+
+    void
+    testFilterPattern()
+    {
+        BOOST_TEST(FilterPattern().matches("anything"));
+        BOOST_TEST(FilterPattern("detail").matches("detail"));
+        BOOST_TEST(!FilterPattern("detail").matches("details"));
+        BOOST_TEST(FilterPattern("*_impl").matches("foo_impl"));
+        BOOST_TEST(FilterPattern("*").subsumes(FilterPattern("a*")));
+        BOOST_TEST(FilterPattern("a*").subsumes(FilterPattern("ab*")));
+        BOOST_TEST(!FilterPattern("ab*").subsumes(FilterPattern("a*")));
+    }
+
+    void run()
+    {
+        testGlob();
+        testFilterPattern();
+    }
+};
+
+TEST_SUITE(
+    Glob_test,
+    "clang.mrdocs.Glob");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,215 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+struct ThreadPool_test
+{
+    static
+    void
+    spinUntil(std::atomic<bool> const& flag)
+    {
+        while (!flag.load())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void
+    testSerial()
+    {
+        // Without threads, work runs before post returns
+        ThreadPool threadPool;
+        BOOST_TEST(threadPool.getThreadCount() == 1);
+        int n = 0;
+        threadPool.async([&]{ ++n; });
+        BOOST_TEST(n == 1);
+
+        TaskGroup taskGroup(threadPool);
+        taskGroup.async([&]{ ++n; });
+        BOOST_TEST(n == 2);
+        taskGroup.async([]{ formatError("failed").Throw(); });
+        BOOST_TEST(taskGroup.wait().size() == 1);
+
+        // So does work submitted from within work
+        taskGroup.async([&]
+        {
+            taskGroup.async([&]{ ++n; });
+            BOOST_TEST(n == 3);
+            ++n;
+        });
+        BOOST_TEST(n == 4);
+        BOOST_TEST(taskGroup.wait().empty());
+    }
+
+    void
+    testRunsAll()
+    {
+        ThreadPool threadPool(4);
+        BOOST_TEST(threadPool.getThreadCount() == 4);
+        std::atomic<std::size_t> n = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            threadPool.async([&]{ ++n; });
+        }
+        threadPool.wait();
+        BOOST_TEST(n.load() == 1000);
+
+        std::vector<int> values(1000);
+        auto errors = threadPool.forEach(values,
+            [](int& v)
+            {
+                ++v;
+            });
+        BOOST_TEST(errors.empty());
+        BOOST_TEST(std::ranges::all_of(values,
+            [](int v)
+            {
+                return v == 1;
+            }));
+    }
+
+    void
+    testErrors()
+    {
+        ThreadPool threadPool(4);
+        TaskGroup taskGroup(threadPool);
+        std::atomic<std::size_t> n = 0;
+        for (int i = 0; i < 100; ++i)
+        {
+            taskGroup.async([&, i]
+            {
+                if (i % 10 == 0)
+                {
+                    formatError("error {}", i).Throw();
+                }
+                ++n;
+            });
+        }
+        BOOST_TEST(taskGroup.wait().size() == 10);
+        BOOST_TEST(n.load() == 90);
+
+        // The errors are returned once
+        BOOST_TEST(taskGroup.wait().empty());
+    }
+
+    void
+    testNested()
+    {
+        // Work which waits for nested work runs
+        // queued work meanwhile, so groups nested
+        // deeper than the number of threads finish
+        ThreadPool threadPool(2);
+        std::atomic<std::size_t> n = 0;
+        auto const nest = [&](auto const& self, int depth) -> void
+        {
+            ++n;
+            if (depth == 0)
+            {
+                return;
+            }
+            TaskGroup taskGroup(threadPool);
+            for (int i = 0; i < 2; ++i)
+            {
+                taskGroup.async([&self, depth]
+                {
+                    self(self, depth - 1);
+                });
+            }
+            static_cast<void>(taskGroup.wait());
+        };
+        TaskGroup taskGroup(threadPool);
+        taskGroup.async([&]{ nest(nest, 6); });
+        BOOST_TEST(taskGroup.wait().empty());
+        BOOST_TEST(n.load() == 127);
+    }
+
+    void
+    testPriority()
+    {
+        ThreadPool threadPool(2);
+        std::atomic<bool> release = false;
+        std::atomic<bool> done = false;
+        std::atomic<std::size_t> started = 0;
+        std::mutex mutex;
+        std::vector<TaskPriority> order;
+
+        // Occupy both threads. One of them is released
+        // once the rest of the work is queued, and the
+        // other once that work ran, so the work runs
+        // on a single thread in order of priority.
+        TaskGroup blockers(threadPool);
+        blockers.async([&]
+        {
+            ++started;
+            spinUntil(release);
+        });
+        blockers.async([&]
+        {
+            ++started;
+            spinUntil(done);
+        });
+        while (started.load() != 2)
+        {
+            std::this_thread::yield();
+        }
+
+        TaskGroup taskGroup(threadPool);
+        for (TaskPriority priority : {
+            TaskPriority::Low,
+            TaskPriority::Normal,
+            TaskPriority::High,
+            TaskPriority::Low,
+            TaskPriority::High })
+        {
+            taskGroup.async(priority, [&, priority]
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(priority);
+            });
+        }
+        release = true;
+        BOOST_TEST(taskGroup.wait().empty());
+        done = true;
+        BOOST_TEST(blockers.wait().empty());
+
+        BOOST_TEST(order == std::vector<TaskPriority>{
+            TaskPriority::High,
+            TaskPriority::High,
+            TaskPriority::Normal,
+            TaskPriority::Low,
+            TaskPriority::Low });
+    }
+
+    void run()
+    {
+        testSerial();
+        testRunsAll();
+        testErrors();
+        testNested();
+        testPriority();
+    }
+};
+
+TEST_SUITE(
+    ThreadPool_test,
+    "clang.mrdocs.ThreadPool");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,129 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2026 agent (agent@local)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Support/any_callable.hpp>
+#include <test_suite/test_suite.hpp>
+#include <array>
+#include <memory>
+#include <utility>
+
+namespace clang {
+namespace mrdocs {
+
+struct any_callable_test
+{
+    /** Counts the live copies of a function object.
+    */
+    template<std::size_t Size>
+    struct Counted
+    {
+        int* live;
+        std::array<char, Size> data{};
+
+        explicit
+        Counted(int* live_) noexcept
+            : live(live_)
+        {
+            ++*live;
+        }
+
+        Counted(Counted&& other) noexcept
+            : live(other.live)
+            , data(other.data)
+        {
+            ++*live;
+        }
+
+        ~Counted()
+        {
+            --*live;
+        }
+
+        int
+        operator()(int x) const
+        {
+            return x + static_cast<int>(Size);
+        }
+    };
+
+    template<std::size_t Size>
+    void
+    checkLifetime()
+    {
+        int live = 0;
+        {
+            any_callable<int(int)> f{ Counted<Size>(&live) };
+            BOOST_TEST(live == 1);
+            BOOST_TEST(f(1) == 1 + static_cast<int>(Size));
+
+            // Moving keeps a single live object
+            any_callable<int(int)> g(std::move(f));
+            BOOST_TEST(live == 1);
+            BOOST_TEST(g(2) == 2 + static_cast<int>(Size));
+
+            // Assigning destroys the previous object
+            any_callable<int(int)> h{ Counted<Size>(&live) };
+            BOOST_TEST(live == 2);
+            h = std::move(g);
+            BOOST_TEST(live == 1);
+            BOOST_TEST(h(3) == 3 + static_cast<int>(Size));
+        }
+        BOOST_TEST(live == 0);
+    }
+
+    void
+    testLifetime()
+    {
+        // Stored inline
+        checkLifetime<8>();
+        // Stored on the heap
+        checkLifetime<256>();
+    }
+
+    void
+    testMoveOnly()
+    {
+        auto p = std::make_unique<int>(42);
+        any_callable<int(void)> f(
+            [p = std::move(p)]
+            {
+                return *p;
+            });
+        any_callable<int(void)> g(std::move(f));
+        BOOST_TEST(g() == 42);
+    }
+
+    void
+    testArguments()
+    {
+        any_callable<std::unique_ptr<int>(std::unique_ptr<int>)> f(
+            [](std::unique_ptr<int> p)
+            {
+                ++*p;
+                return p;
+            });
+        auto p = f(std::make_unique<int>(1));
+        BOOST_TEST(*p == 2);
+    }
+
+    void run()
+    {
+        testLifetime();
+        testMoveOnly();
+        testArguments();
+    }
+};
+
+TEST_SUITE(
+    any_callable_test,
+    "clang.mrdocs.any_callable");
+
+} // mrdocs
+} // clang
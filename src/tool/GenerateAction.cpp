@@ -16,6 +16,7 @@
 #include "lib/Lib/CorpusImpl.hpp"
 #include "lib/Lib/MrDocsCompilationDatabase.hpp"
 #include "lib/Support/Path.hpp"
+#include "lib/Support/Stats.hpp"
 #include "llvm/Support/Program.h"
 #include <mrdocs/Generators.hpp>
 #include <mrdocs/Support/Error.hpp>
@@ -82,41 +83,12 @@ generateCompileCommandsFile(llvm::StringRef inputPath, llvm::StringRef cmakeArgs
     return Unexpected(Error("Input path is not a directory, a CMakeLists.txt file, or a compile_commands.json file"));
 }
 
-} // anonymous namespace
-
-
-Expected<void>
-DoGenerateAction(
-    std::string const& configPath,
-    Config::Settings::ReferenceDirectories const& dirs,
-    char const** argv)
+/** Extract the corpus from the compilation database in the configuration.
+*/
+Expected<std::unique_ptr<Corpus>>
+buildCorpus(std::shared_ptr<ConfigImpl const> const& config)
 {
-    // --------------------------------------------------------------
-    //
-    // Load configuration
-    //
-    // --------------------------------------------------------------
-    Config::Settings publicSettings;
-    MRDOCS_TRY(Config::Settings::load_file(publicSettings, configPath, dirs));
-    MRDOCS_TRY(toolArgs.apply(publicSettings, dirs, argv));
-    MRDOCS_TRY(publicSettings.normalize(dirs));
-    ThreadPool threadPool(publicSettings.concurrency);
-    MRDOCS_TRY(
-        std::shared_ptr<ConfigImpl const> config,
-        ConfigImpl::load(publicSettings, dirs, threadPool));
-
-    // --------------------------------------------------------------
-    //
-    // Load generator
-    //
-    // --------------------------------------------------------------
     auto& settings = config->settings();
-    MRDOCS_TRY(
-        Generator const& generator,
-        getGenerators().find(to_string(settings.generate)),
-        formatError(
-            "the Generator \"{}\" was not found",
-            to_string(config->settings().generate)));
 
     // --------------------------------------------------------------
     //
@@ -183,14 +155,104 @@ DoGenerateAction(
     // Build corpus
     //
     // --------------------------------------------------------------
+    return CorpusImpl::build(
+        report::Level::info, config, compilationDatabase);
+}
+
+} // anonymous namespace
+
+
+Expected<void>
+DoGenerateAction(
+    std::string const& configPath,
+    Config::Settings::ReferenceDirectories const& dirs,
+    char const** argv)
+{
+    // --------------------------------------------------------------
+    //
+    // Load configuration
+    //
+    // --------------------------------------------------------------
+    Config::Settings publicSettings;
+    MRDOCS_TRY(Config::Settings::load_file(publicSettings, configPath, dirs));
+    MRDOCS_TRY(toolArgs.apply(publicSettings, dirs, argv));
+    MRDOCS_TRY(publicSettings.normalize(dirs));
+    ThreadPool threadPool(publicSettings.concurrency);
+    MRDOCS_TRY(
+        std::shared_ptr<ConfigImpl const> config,
+        ConfigImpl::load(publicSettings, dirs, threadPool));
+
+    // --------------------------------------------------------------
+    //
+    // Load generator
+    //
+    // --------------------------------------------------------------
+    auto& settings = config->settings();
     MRDOCS_TRY(
-        std::unique_ptr<Corpus> corpus,
-        CorpusImpl::build(
-            report::Level::info, config, compilationDatabase));
+        Generator const& generator,
+        getGenerators().find(to_string(settings.generate)),
+        formatError(
+            "the Generator \"{}\" was not found",
+            to_string(config->settings().generate)));
+
+    // Statistics are written on every successful path
+    if (!settings.stats.empty())
+    {
+        Stats::get().enable();
+    }
+    auto writeStats = [&]() -> Expected<void>
+    {
+        if (settings.stats.empty())
+        {
+            return {};
+        }
+        report::info("Writing statistics to \"{}\"", settings.stats);
+        return Stats::get().write(settings.stats);
+    };
+
+    // --------------------------------------------------------------
+    //
+    // Load or build corpus
+    //
+    // --------------------------------------------------------------
+    // A shard only extracts part of the symbols,
+    // which are merged by a later run
+    if (!settings.shard.empty() && settings.corpusOut.empty())
+    {
+        return Unexpected(formatError(
+            "The shard option requires corpus-out"));
+    }
+
+    std::unique_ptr<Corpus> corpus;
+    if (!settings.corpusIn.empty())
+    {
+        MRDOCS_TRY(corpus, CorpusImpl::load(
+            report::Level::info, config, settings.corpusIn));
+    }
+    else
+    {
+        MRDOCS_TRY(corpus, buildCorpus(config));
+    }
+
+    // --------------------------------------------------------------
+    //
+    // Save corpus
+    //
+    // --------------------------------------------------------------
+    if (!settings.corpusOut.empty())
+    {
+        report::info("Writing corpus to \"{}\"", settings.corpusOut);
+        Stats::Timer saveTimer;
+        MRDOCS_TRY(static_cast<CorpusImpl const&>(
+            *corpus).save(settings.corpusOut));
+        Stats::get().addPhase("save", saveTimer.elapsed());
+        return writeStats();
+    }
+
     if (corpus->empty())
     {
         report::warn("Corpus is empty, not generating docs");
-        return {};
+        return writeStats();
     }
 
     // --------------------------------------------------------------
@@ -205,7 +267,9 @@ DoGenerateAction(
             settings.output,
             (*config)->configDir));
     report::info("Generating docs\n");
+    Stats::Timer generateTimer;
     MRDOCS_TRY(generator.build(absOutput, *corpus));
+    Stats::get().addPhase("generate", generateTimer.elapsed());
 
     // --------------------------------------------------------------
     //
@@ -213,7 +277,7 @@ DoGenerateAction(
     //
     // --------------------------------------------------------------
 
-    return {};
+    return writeStats();
 }
 
 } // mrdocs
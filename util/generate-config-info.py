@@ -62,7 +62,8 @@ def get_flat_suboptions(option_name, options):
 def get_valid_enum_categories():
     valid_enum_cats = {
         'generator': ["adoc", "html", "xml"],
-        "extract-policy": ["always", "dependency", "never"]
+        "extract-policy": ["always", "dependency", "never"],
+        "symbol-id-hash": ["sha1", "xxh3"]
     }
     return valid_enum_cats
 